@@ -0,0 +1,37 @@
+/**
+ * @file main.simplelog_ctl.cpp
+ * Command-line client for the simplelog ControlServer (Unix-domain socket).
+ *
+ * USAGE: simplelog_ctl <socket_path> <command> [<args>...]
+ *
+ * @code
+ *  $ simplelog_ctl /tmp/myapp.logctl help
+ *  $ simplelog_ctl /tmp/myapp.logctl set "foo.*" debug
+ *  $ simplelog_ctl /tmp/myapp.logctl list
+ *  $ simplelog_ctl /tmp/myapp.logctl flush
+ * @endcode
+ **/
+
+// -- INCLUDES:
+#include "simplelog/backend/common/ControlServer.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+
+int main(int argc, char **argv)
+{
+    if (argc < 3) {
+        std::cerr << "USAGE: " << argv[0] << " <socket_path> <command> [<args>...]\n";
+        return EXIT_FAILURE;
+    }
+
+    std::string commandLine(argv[2]);
+    for (int i = 3; i < argc; ++i) {
+        commandLine += std::string(" ") + argv[i];
+    }
+    using simplelog::backend_common::sendControlCommand;
+    const auto response = sendControlCommand(argv[1], commandLine);
+    std::cout << response;
+    return (response.rfind("ERROR:", 0) == 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
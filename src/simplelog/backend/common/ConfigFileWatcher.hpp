@@ -0,0 +1,212 @@
+/**
+ * @file simplelog/backend/common/ConfigFileWatcher.hpp
+ * Simplelog common backend watcher thread for a logging config file (Linux).
+ *
+ * Uses inotify to detect changes of the config file and calls a callback
+ * (in the watcher thread) to apply the new config to the live loggers.
+ *
+ * @code
+ *  // -- EXAMPLE: With BACKEND=spdlog
+ *  using simplelog::backend_common::ConfigFileWatcher;
+ *  using simplelog::backend_common::readLevelConfigFile;
+ *  ConfigFileWatcher watcher("/etc/myapp/logging.conf", [](const std::string& path) {
+ *      simplelog::backend_spdlog::applyLevelConfig(readLevelConfigFile(path));
+ *  });
+ *  watcher.start();
+ * @endcode
+ *
+ * @see https://man7.org/linux/man-pages/man7/inotify.7.html
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include "simplelog/detail/DiagMacros.hpp"
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <string>
+#include <thread>
+
+
+// --------------------------------------------------------------------------
+// LOGGING CONFIG FILE WATCHER
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_common {
+
+namespace detail {
+
+/**
+ * Checks the inotify events (as read from the inotify file descriptor).
+ * @return true, if the config file was changed (or events were lost).
+ **/
+inline bool hasConfigFileEvent(const char* buffer, std::size_t size,
+                               const std::string& filename)
+{
+    bool changed = false;
+    for (const char* ptr = buffer; ptr < buffer + size; ) {
+        const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+        if (event->mask & IN_Q_OVERFLOW) {
+            changed = true;     //< EVENTS LOST: Config file may have changed.
+        } else if ((event->len > 0) && (filename == event->name)) {
+            changed = true;
+        }
+        ptr += sizeof(inotify_event) + event->len;
+    }
+    return changed;
+}
+
+} //< NAMESPACE-END: detail
+
+/**
+ * @class ConfigFileWatcher
+ * Watches a config file and calls the callback after each change.
+ *
+ * The directory of the file is watched (not the file itself).
+ * Therefore, editors that replace the file (write to tmpfile and rename)
+ * are detected, too.
+ *
+ * @note The callback is called in the watcher thread.
+ *       Logging threads are not blocked by the watcher.
+ *       An exception of the callback is reported (DIAG) and ignored.
+ * @note The watcher thread stops if poll() fails (isRunning() is false then).
+ **/
+class ConfigFileWatcher
+{
+public:
+    using Callback = std::function<void(const std::string& path)>;
+
+private:
+    std::string m_path;
+    std::string m_directory;
+    std::string m_filename;
+    Callback m_callback;
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_failed;     //< Watcher thread stopped on poll() error.
+    int m_inotifyFd;
+    int m_stopFd;   //< eventfd: Wakes up watcher thread on stop().
+
+public:
+    ConfigFileWatcher(std::string path, Callback callback)
+        : m_path(std::move(path)), m_directory("."), m_filename(m_path),
+          m_callback(std::move(callback)), m_thread(), m_running(false),
+          m_failed(false), m_inotifyFd(-1), m_stopFd(-1)
+    {
+        const auto pos = m_path.rfind('/');
+        if (pos != std::string::npos) {
+            m_directory = (pos == 0) ? std::string("/") : m_path.substr(0, pos);
+            m_filename = m_path.substr(pos + 1);
+        }
+    }
+    ~ConfigFileWatcher() { stop(); }
+    ConfigFileWatcher(const ConfigFileWatcher&) = delete;
+    ConfigFileWatcher& operator=(const ConfigFileWatcher&) = delete;
+
+    const std::string& getPath() const { return m_path; }
+    bool isRunning() const { return m_running && !m_failed; }
+
+    /**
+     * Starts the watcher thread.
+     * @return true, on success. false, if inotify could not be used.
+     **/
+    bool start()
+    {
+        if (m_running) {
+            return true;
+        }
+        m_inotifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        m_stopFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO;
+        if ((m_inotifyFd < 0) || (m_stopFd < 0) ||
+            (::inotify_add_watch(m_inotifyFd, m_directory.c_str(), mask) < 0)) {
+            closeFiles();
+            return false;
+        }
+        m_failed = false;
+        m_running = true;
+        m_thread = std::thread([this]() { run(); });
+        return true;
+    }
+
+    //! Stops the watcher thread (and waits until it is finished).
+    void stop()
+    {
+        if (!m_running.exchange(false)) {
+            return;
+        }
+        const std::uint64_t value = 1;
+        if (::write(m_stopFd, &value, sizeof(value)) < 0) {
+            // -- IGNORE: Can only fail if eventfd counter overflows.
+        }
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        closeFiles();
+    }
+
+private:
+    void closeFiles()
+    {
+        if (m_inotifyFd >= 0) { ::close(m_inotifyFd); m_inotifyFd = -1; }
+        if (m_stopFd >= 0)    { ::close(m_stopFd);    m_stopFd = -1; }
+    }
+
+    //! Reads all pending events. @return true, if config file was changed.
+    bool readEvents()
+    {
+        alignas(inotify_event) char buffer[4096];
+        bool changed = false;
+        ssize_t size;
+        while ((size = ::read(m_inotifyFd, buffer, sizeof(buffer))) > 0) {
+            if (detail::hasConfigFileEvent(buffer, static_cast<std::size_t>(size), m_filename)) {
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    void run()
+    {
+        pollfd fds[2] = {
+            { m_inotifyFd, POLLIN, 0 },
+            { m_stopFd,    POLLIN, 0 }
+        };
+        while (m_running) {
+            if (::poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                m_failed = true;    //< PERSISTENT ERROR: Stop instead of spinning.
+                break;
+            }
+            if (fds[1].revents & POLLIN) {
+                break;
+            }
+            // -- HINT: Several events per change are coalesced into one callback.
+            if ((fds[0].revents & POLLIN) && readEvents() && m_callback) {
+                callCallback();
+            }
+        }
+    }
+
+    void callCallback()
+    {
+        try {
+            m_callback(m_path);
+        } catch (const std::exception& e) {
+            SIMPLELOG_DIAG_TRACE0("ConfigFileWatcher: Callback failed: " << e.what());
+        } catch (...) {
+            SIMPLELOG_DIAG_TRACE0("ConfigFileWatcher: Callback failed: UNKNOWN_EXCEPTION");
+        }
+    }
+};
+
+}} //< NAMESPACE-END: simplelog::backend_common
@@ -0,0 +1,278 @@
+/**
+ * @file simplelog/backend/common/ControlServer.hpp
+ * Simplelog common backend control server on a local Unix-domain socket.
+ *
+ * Allows to change the logging config of a running process, like:
+ *
+ * @code
+ *  $ simplelog_ctl /tmp/myapp.logctl set "foo.*" debug
+ *  $ simplelog_ctl /tmp/myapp.logctl list
+ * @endcode
+ *
+ * PROTOCOL: The client sends one command line (words separated by spaces).
+ * The server sends the response text and closes the connection.
+ * A failed command has a response that starts with "ERROR:".
+ *
+ * @see https://man7.org/linux/man-pages/man7/unix.7.html
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <sys/socket.h>
+#include <sys/stat.h>   //< USE: chmod()
+#include <sys/time.h>   //< USE: timeval
+#include <sys/eventfd.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// --------------------------------------------------------------------------
+// LOGGING CONTROL SERVER
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_common {
+
+/**
+ * @class ControlServer
+ * Runs a thread that accepts control commands on a Unix-domain socket.
+ * Commands are registered with addCommand() (normally by the backend, like:
+ * backend_spdlog::addControlCommands()) before start() is called.
+ *
+ * @note Commands are executed in the server thread (one at a time).
+ *       Logging threads are not blocked by the server.
+ **/
+class ControlServer
+{
+public:
+    using Arguments = std::vector<std::string>;
+    using CommandHandler = std::function<std::string(const Arguments&)>;
+    static constexpr std::size_t MAX_COMMAND_SIZE = 4096;
+
+private:
+    struct Command
+    {
+        std::string usage;
+        CommandHandler handler;
+    };
+
+    std::string m_path;
+    std::map<std::string, Command> m_commands;
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+    int m_listenFd;
+    int m_stopFd;   //< eventfd: Wakes up server thread on stop().
+
+public:
+    explicit ControlServer(std::string path)
+        : m_path(std::move(path)), m_commands(), m_thread(),
+          m_running(false), m_listenFd(-1), m_stopFd(-1)
+    {
+        addCommand("help", "help", [this](const Arguments&) {
+            std::string text;
+            for (const auto& command : m_commands) {
+                text += command.second.usage + "\n";
+            }
+            return text;
+        });
+    }
+    ~ControlServer() { stop(); }
+    ControlServer(const ControlServer&) = delete;
+    ControlServer& operator=(const ControlServer&) = delete;
+
+    const std::string& getPath() const { return m_path; }
+    bool isRunning() const { return m_running; }
+
+    /**
+     * Registers a command (or replaces a command with the same name).
+     * @note Must be called before start().
+     **/
+    void addCommand(const std::string& name, std::string usage, CommandHandler handler)
+    {
+        m_commands[name] = Command{ std::move(usage), std::move(handler) };
+    }
+
+    /**
+     * Executes a command line (as received from a client).
+     * @note An exception of the handler is returned as "ERROR: <what>".
+     **/
+    std::string execute(const std::string& commandLine) const
+    {
+        Arguments words;
+        std::istringstream input(commandLine);
+        for (std::string word; input >> word; ) {
+            words.push_back(word);
+        }
+        if (words.empty()) {
+            return "ERROR: Missing command (use: help)\n";
+        }
+        const auto commandIter = m_commands.find(words.front());
+        if (commandIter == m_commands.end()) {
+            return "ERROR: Unknown command: " + words.front() + "\n";
+        }
+        const Arguments args(words.begin() + 1, words.end());
+        try {
+            return commandIter->second.handler(args);
+        } catch (const std::exception& e) {
+            return std::string("ERROR: ") + e.what() + "\n";
+        } catch (...) {
+            return "ERROR: Unknown exception\n";
+        }
+    }
+
+    /**
+     * Creates the socket and starts the server thread.
+     * An old socket file with the same path is removed.
+     * The socket file is only accessible by the owner (mode: 0600).
+     * @return true, on success. false, if the socket could not be created.
+     **/
+    bool start()
+    {
+        if (m_running) {
+            return true;
+        }
+        sockaddr_un address{};
+        if (m_path.size() >= sizeof(address.sun_path)) {
+            return false;
+        }
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, m_path.c_str(), sizeof(address.sun_path) - 1);
+
+        ::unlink(m_path.c_str());
+        m_listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        m_stopFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if ((m_listenFd < 0) || (m_stopFd < 0) ||
+            (::bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) ||
+            (::chmod(m_path.c_str(), S_IRUSR | S_IWUSR) < 0) ||  //< BEFORE: listen()
+            (::listen(m_listenFd, 4) < 0)) {
+            closeFiles();
+            return false;
+        }
+        m_running = true;
+        m_thread = std::thread([this]() { run(); });
+        return true;
+    }
+
+    //! Stops the server thread and removes the socket file.
+    void stop()
+    {
+        if (!m_running.exchange(false)) {
+            return;
+        }
+        const std::uint64_t value = 1;
+        if (::write(m_stopFd, &value, sizeof(value)) < 0) {
+            // -- IGNORE: Can only fail if eventfd counter overflows.
+        }
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        closeFiles();
+        ::unlink(m_path.c_str());
+    }
+
+private:
+    void closeFiles()
+    {
+        if (m_listenFd >= 0) { ::close(m_listenFd); m_listenFd = -1; }
+        if (m_stopFd >= 0)   { ::close(m_stopFd);   m_stopFd = -1; }
+    }
+
+    void handleConnection(int fd) const
+    {
+        // -- HINT: A slow or stuck client must not block the server forever.
+        const timeval timeout{ 1, 0 };
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        std::string commandLine;
+        char buffer[256];
+        ssize_t size;
+        while ((commandLine.size() < MAX_COMMAND_SIZE) &&
+               ((size = ::recv(fd, buffer, sizeof(buffer), 0)) > 0)) {
+            commandLine.append(buffer, static_cast<std::size_t>(size));
+            if (commandLine.find('\n') != std::string::npos) {
+                break;
+            }
+        }
+        const std::string response = execute(commandLine.substr(0, commandLine.find('\n')));
+        for (std::size_t sent = 0; sent < response.size(); ) {
+            size = ::send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+            if (size <= 0) {
+                break;
+            }
+            sent += static_cast<std::size_t>(size);
+        }
+    }
+
+    void run()
+    {
+        pollfd fds[2] = {
+            { m_listenFd, POLLIN, 0 },
+            { m_stopFd,   POLLIN, 0 }
+        };
+        while (m_running) {
+            if (::poll(fds, 2, -1) < 0) {
+                continue;   //< EINTR
+            }
+            if (fds[1].revents & POLLIN) {
+                break;
+            }
+            if (fds[0].revents & POLLIN) {
+                const int fd = ::accept4(m_listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+                if (fd >= 0) {
+                    handleConnection(fd);
+                    ::close(fd);
+                }
+            }
+        }
+    }
+};
+
+/**
+ * Sends a command to a ControlServer and returns its response.
+ * @return Response text (or "ERROR: ..." if the server is not reachable).
+ **/
+inline std::string sendControlCommand(const std::string& path, const std::string& commandLine)
+{
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        return "ERROR: Socket path is too long\n";
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if ((fd < 0) ||
+        (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return "ERROR: Cannot connect to: " + path + "\n";
+    }
+
+    const std::string request = commandLine + "\n";
+    if (::send(fd, request.data(), request.size(), MSG_NOSIGNAL) < 0) {
+        ::close(fd);
+        return "ERROR: Cannot send to: " + path + "\n";
+    }
+    std::string response;
+    char buffer[1024];
+    ssize_t size;
+    while ((size = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<std::size_t>(size));
+    }
+    ::close(fd);
+    return response;
+}
+
+}} //< NAMESPACE-END: simplelog::backend_common
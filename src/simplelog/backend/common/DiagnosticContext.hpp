@@ -0,0 +1,185 @@
+/**
+ * @file simplelog/backend/common/DiagnosticContext.hpp
+ * Simplelog common backend thread-local diagnostic context (MDC).
+ *
+ * A diagnostic context is a stack of key/value pairs (request id, tenant, ...)
+ * of the current thread that is attached to each log-record of this thread.
+ *
+ * @code
+ *  void handleRequest(const Request& request)
+ *  {
+ *      using simplelog::backend_common::DiagnosticContextScope;
+ *      DiagnosticContextScope requestScope("request", request.id());
+ *      DiagnosticContextScope tenantScope("tenant", request.tenant());
+ *      SLOG_INFO("Start processing");  //< PREFIX: "[request=42 tenant=acme] "
+ *  }
+ * @endcode
+ *
+ * The rendered prefix (and journal fields) are cached per thread.
+ * They are only rendered again after the context was changed
+ * (and not for each log-record).
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <cctype>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+// --------------------------------------------------------------------------
+// LOGGING DIAGNOSTIC CONTEXT
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_common {
+
+struct DiagnosticContextEntry
+{
+    std::string key;
+    std::string value;
+};
+
+/**
+ * @class DiagnosticContext
+ * Diagnostic context of one thread (use: DiagnosticContext::current()).
+ **/
+class DiagnosticContext
+{
+private:
+    std::vector<DiagnosticContextEntry> m_entries;
+    std::string m_prefix;
+    std::vector<std::string> m_fields;
+    bool m_changed;
+
+public:
+    DiagnosticContext() : m_entries(), m_prefix(), m_fields(), m_changed(false) {}
+
+    //! Diagnostic context of the current thread.
+    static DiagnosticContext& current();
+
+    bool empty() const { return m_entries.empty(); }
+    std::size_t size() const { return m_entries.size(); }
+    const std::vector<DiagnosticContextEntry>& getEntries() const { return m_entries; }
+
+    void push(std::string key, std::string value);
+    void pop();
+
+    /**
+     * Returns the cached prefix for log-records (as: "[request=42 tenant=acme] ").
+     * @note The prefix is only rendered again after the context was changed.
+     **/
+    const std::string& getPrefix()
+    {
+        renderIfChanged();
+        return m_prefix;
+    }
+
+    /**
+     * Returns the cached journal fields (as: "REQUEST=42", "TENANT=acme").
+     * @note Field names are uppercased (other chars than [A-Z0-9] become '_').
+     **/
+    const std::vector<std::string>& getJournalFields()
+    {
+        renderIfChanged();
+        return m_fields;
+    }
+
+    static std::string makeJournalFieldName(const std::string& key)
+    {
+        std::string name;
+        for (const char c : key) {
+            const auto uc = static_cast<unsigned char>(c);
+            name += std::isalnum(uc) ? static_cast<char>(std::toupper(uc)) : '_';
+        }
+        // -- HINT: Field names with leading underscore are reserved by journald.
+        const auto pos = name.find_first_not_of('_');
+        return (pos == std::string::npos) ? std::string("CONTEXT") : name.substr(pos);
+    }
+
+private:
+    void renderIfChanged()
+    {
+        if (!m_changed) {
+            return;
+        }
+        m_prefix.clear();
+        m_fields.clear();
+        for (const auto& entry : m_entries) {
+            m_prefix += (m_prefix.empty() ? "[" : " ") + entry.key + "=" + entry.value;
+            m_fields.push_back(makeJournalFieldName(entry.key) + "=" + entry.value);
+        }
+        if (!m_prefix.empty()) {
+            m_prefix += "] ";
+        }
+        m_changed = false;
+    }
+};
+
+namespace detail {
+
+//! Size of the context of this thread (trivial: No TLS init guard).
+inline thread_local std::size_t diagnosticContextSize = 0;
+
+} //< NAMESPACE-END: detail
+
+inline DiagnosticContext& DiagnosticContext::current()
+{
+    thread_local DiagnosticContext theContext;
+    return theContext;
+}
+
+inline void DiagnosticContext::push(std::string key, std::string value)
+{
+    m_entries.push_back({std::move(key), std::move(value)});
+    m_changed = true;
+    if (this == &current()) {
+        detail::diagnosticContextSize = m_entries.size();
+    }
+}
+
+inline void DiagnosticContext::pop()
+{
+    if (m_entries.empty()) {
+        return;
+    }
+    m_entries.pop_back();
+    m_changed = true;
+    if (this == &current()) {
+        detail::diagnosticContextSize = m_entries.size();
+    }
+}
+
+//! Indicates if the current thread has a diagnostic context (FAST PATH).
+inline bool hasDiagnosticContext()
+{
+    return detail::diagnosticContextSize != 0;
+}
+
+//! Returns the cached prefix of the current thread (or an empty string).
+inline const std::string& getDiagnosticContextPrefix()
+{
+    static const std::string emptyPrefix;
+    return hasDiagnosticContext() ? DiagnosticContext::current().getPrefix() : emptyPrefix;
+}
+
+/**
+ * @class DiagnosticContextScope
+ * RAII scope: Adds a key/value pair to the diagnostic context of this thread.
+ **/
+class DiagnosticContextScope
+{
+public:
+    DiagnosticContextScope(std::string key, std::string value)
+    {
+        DiagnosticContext::current().push(std::move(key), std::move(value));
+    }
+    ~DiagnosticContextScope()
+    {
+        DiagnosticContext::current().pop();
+    }
+    DiagnosticContextScope(const DiagnosticContextScope&) = delete;
+    DiagnosticContextScope& operator=(const DiagnosticContextScope&) = delete;
+};
+
+}} //< NAMESPACE-END: simplelog::backend_common
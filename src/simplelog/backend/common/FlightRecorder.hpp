@@ -0,0 +1,410 @@
+/**
+ * @file simplelog/backend/common/FlightRecorder.hpp
+ * Simplelog common backend flight recorder (per-thread ring buffer).
+ *
+ * Each thread keeps the last N log-records that were disabled by the
+ * module level (DEBUG, INFO, ...). The records are captured in binary form:
+ * Arithmetic args, copied format string and string bytes (memcpy).
+ * A format string that is marked as FormatLiteral is captured as pointer.
+ * They are only formatted if the ring is dumped:
+ *
+ *   - AUTOMATIC: When the thread logs an ERROR (or more severe) log-record.
+ *   - ON DEMAND: With dumpFlightRecorder() or dumpAllFlightRecorders().
+ *
+ * @code
+ *  simplelog::backend_common::enableFlightRecorder();
+ *  SLOG_DEBUG("Connect to {0}:{1}", host, port);   //< DISABLED: Is recorded.
+ *  SLOG_ERROR("Connection failed");                //< Dumps DEBUG record first.
+ * @endcode
+ *
+ * FAST PATH: If disabled, one relaxed atomic read per disabled log-record.
+ * @note Args other than arithmetic values and strings are formatted
+ *       when the log-record is captured (SLOW PATH).
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// -- AUTO-CONFIGURE:
+#ifndef SIMPLELOG_BACKEND_COMMON__FLIGHT_RECORDER_CAPACITY
+#define SIMPLELOG_BACKEND_COMMON__FLIGHT_RECORDER_CAPACITY 64
+#endif
+
+
+// --------------------------------------------------------------------------
+// LOGGING FLIGHT RECORDER
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_common {
+
+/**
+ * @class FlightRecord
+ * Captured log-record (fixed size: No allocation when captured).
+ **/
+struct FlightRecord
+{
+    using Clock = std::chrono::system_clock;
+    using RenderFunc = void (*)(const FlightRecord& record, std::string& text);
+    static constexpr std::size_t NAME_CAPACITY = 48;
+    static constexpr std::size_t DATA_CAPACITY = 192;
+
+    Clock::time_point time;
+    int level;                  //< Backend level (as: SIMPLELOG_BACKEND_LEVEL_DEBUG)
+    RenderFunc render;          //< Formats the captured data.
+    const char* format;         //< FormatLiteral (or nullptr: Is copied into data).
+    std::size_t formatSize;
+    std::size_t nameSize;
+    char name[NAME_CAPACITY];
+    alignas(std::max_align_t) unsigned char data[DATA_CAPACITY];
+
+    std::string_view getName() const { return std::string_view(name, nameSize); }
+
+    std::string getText() const
+    {
+        std::string text;
+        render(*this, text);
+        return text;
+    }
+};
+
+/**
+ * @class FlightRecorder
+ * Ring buffer with the last FlightRecord(s) of one thread.
+ * @note The mutex is only contended if another thread dumps this ring.
+ **/
+class FlightRecorder
+{
+private:
+    std::mutex m_mutex;
+    std::vector<FlightRecord> m_records;
+    std::size_t m_next;
+    std::size_t m_size;
+
+public:
+    explicit FlightRecorder(std::size_t capacity = SIMPLELOG_BACKEND_COMMON__FLIGHT_RECORDER_CAPACITY)
+        : m_mutex(), m_records(std::max<std::size_t>(capacity, 1)), m_next(0), m_size(0)
+    {}
+
+    std::size_t capacity() const { return m_records.size(); }
+
+    std::size_t size()
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_size;
+    }
+
+    //! Captures a log-record (overwrites the oldest one if the ring is full).
+    template<typename CaptureFuncT>
+    void capture(const CaptureFuncT& captureFunc)
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        captureFunc(m_records[m_next]);
+        m_next = (m_next + 1) % m_records.size();
+        m_size = std::min(m_size + 1, m_records.size());
+    }
+
+    //! Removes all records (oldest first) from the ring.
+    std::vector<FlightRecord> takeRecords()
+    {
+        std::vector<FlightRecord> records;
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        records.reserve(m_size);
+        const auto first = (m_next + m_records.size() - m_size) % m_records.size();
+        for (std::size_t i = 0; i < m_size; ++i) {
+            records.push_back(m_records[(first + i) % m_records.size()]);
+        }
+        m_size = 0;
+        return records;
+    }
+};
+
+using FlightRecorderPtr = std::shared_ptr<FlightRecorder>;
+
+/**
+ * @struct FormatLiteral
+ * Marks a format string with static storage duration (as: a string literal).
+ * The flight recorder captures only its pointer (instead of its bytes).
+ *
+ * @code
+ *  using simplelog::backend_common::FormatLiteral;
+ *  recordInFlightRecorder<FormatterT>("foo", level, FormatLiteral{"Hello {0}"}, name);
+ * @endcode
+ **/
+struct FormatLiteral
+{
+    const char* format;
+};
+
+namespace detail {
+
+inline std::atomic<bool> flightRecorderEnabled(false);
+
+//! Number of captured records of this thread (trivial: No TLS init guard).
+//! @note Only a hint: Another thread may have dumped the records.
+inline thread_local std::size_t flightRecordCount = 0;
+
+struct FlightRecorderRegistry
+{
+    std::mutex mutex;
+    std::vector<FlightRecorderPtr> recorders;
+};
+
+inline FlightRecorderRegistry& getFlightRecorderRegistry()
+{
+    static FlightRecorderRegistry theRegistry;
+    return theRegistry;
+}
+
+//! Registers the FlightRecorder of a thread (until the thread ends).
+class ThreadFlightRecorder
+{
+public:
+    FlightRecorderPtr recorder;
+
+    ThreadFlightRecorder() : recorder(std::make_shared<FlightRecorder>())
+    {
+        auto& registry = getFlightRecorderRegistry();
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.recorders.push_back(recorder);
+    }
+    ~ThreadFlightRecorder()
+    {
+        auto& registry = getFlightRecorderRegistry();
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto& recorders = registry.recorders;
+        recorders.erase(std::remove(recorders.begin(), recorders.end(), recorder), recorders.end());
+    }
+};
+
+inline FlightRecorder& getThreadFlightRecorder()
+{
+    thread_local ThreadFlightRecorder theRecorder;
+    return *theRecorder.recorder;
+}
+
+// -- CAPTURE ARGS: Arithmetic values are stored as is, strings as bytes.
+struct CapturedString
+{
+    std::size_t offset;
+    std::size_t size;
+};
+
+template<typename T>
+struct IsCapturedString
+    : std::integral_constant<bool,
+        std::is_convertible<const T&, std::string_view>::value &&
+        !std::is_arithmetic<T>::value>
+{};
+
+template<typename T>
+struct IsCapturable
+    : std::integral_constant<bool, std::is_arithmetic<T>::value || IsCapturedString<T>::value>
+{};
+
+template<typename T>
+using CapturedType = typename std::conditional<IsCapturedString<T>::value,
+                                               CapturedString, T>::type;
+
+template<typename T>
+inline CapturedType<T> captureArg(const T& arg, FlightRecord& record, std::size_t& offset)
+{
+    if constexpr (IsCapturedString<T>::value) {
+        const std::string_view text(arg);
+        const auto size = std::min(text.size(), FlightRecord::DATA_CAPACITY - offset);
+        std::memcpy(record.data + offset, text.data(), size);
+        const CapturedString captured{offset, size};
+        offset += size;
+        return captured;
+    } else {
+        return arg;
+    }
+}
+
+template<typename T>
+inline const T& restoreArg(const T& arg, const FlightRecord&) { return arg; }
+
+inline std::string_view restoreArg(const CapturedString& arg, const FlightRecord& record)
+{
+    return std::string_view(reinterpret_cast<const char*>(record.data) + arg.offset, arg.size);
+}
+
+template<typename T>
+inline void writeArg(FlightRecord& record, std::size_t& offset, const T& value)
+{
+    std::memcpy(record.data + offset, static_cast<const void*>(&value), sizeof(T));
+    offset += sizeof(T);
+}
+
+template<typename T>
+inline T readArg(const FlightRecord& record, std::size_t& offset)
+{
+    T value;
+    std::memcpy(static_cast<void*>(&value), record.data + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+}
+
+//! Size of the captured args (the format string is stored after them).
+template<typename... Args>
+constexpr std::size_t getCapturedArgsSize()
+{
+    return (std::size_t(0) + ... + sizeof(CapturedType<Args>));
+}
+
+template<typename FormatterT, typename... Args>
+inline void renderCapturedArgs(const FlightRecord& record, std::string& text)
+{
+    [[maybe_unused]] std::size_t offset = 0;
+    // -- HINT: Braced-init-list evaluates the args from left to right.
+    const std::tuple<CapturedType<Args>...> captured{readArg<CapturedType<Args>>(record, offset)...};
+    const auto* formatData = record.format ? record.format :
+        reinterpret_cast<const char*>(record.data) + getCapturedArgsSize<Args...>();
+    const std::string_view format(formatData, record.formatSize);
+    std::apply([&](const auto&... args) {
+        FormatterT::format(text, format, restoreArg(args, record)...);
+    }, captured);
+}
+
+template<typename FormatT>
+inline decltype(auto) toFormat(const FormatT& format)
+{
+    if constexpr (std::is_same<FormatT, FormatLiteral>::value) {
+        return std::string_view(format.format);
+    } else {
+        return format;
+    }
+}
+
+inline void renderText(const FlightRecord& record, std::string& text)
+{
+    text.assign(reinterpret_cast<const char*>(record.data), std::strlen(reinterpret_cast<const char*>(record.data)));
+}
+
+} //< NAMESPACE-END: detail
+
+//! Enables (or disables) the flight recorder of all threads.
+inline void enableFlightRecorder(bool enabled = true)
+{
+    detail::flightRecorderEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+//! Indicates if disabled log-records are captured (FAST PATH).
+inline bool isFlightRecorderEnabled()
+{
+    return detail::flightRecorderEnabled.load(std::memory_order_relaxed);
+}
+
+//! Indicates if the current thread may have captured records (FAST PATH).
+inline bool hasFlightRecords()
+{
+    return detail::flightRecordCount != 0;
+}
+
+/**
+ * Captures a disabled log-record in the flight recorder of this thread.
+ * @param moduleName  Name of the module (logger).
+ * @param level       Backend level of the log-record.
+ * @param format      Format string (bytes are copied) or FormatLiteral (pointer is kept).
+ * @tparam FormatterT Backend formatter with:
+ *                    static void format(std::string& text, std::string_view format, args...)
+ **/
+template<typename FormatterT, typename FormatT, typename... Args>
+inline void recordInFlightRecorder(std::string_view moduleName, int level,
+                                   const FormatT& format, const Args&... args)
+{
+    constexpr bool isLiteral = std::is_same<FormatT, FormatLiteral>::value;
+    constexpr std::size_t capturedArgsSize = detail::getCapturedArgsSize<Args...>();
+    constexpr bool useCapturedArgs =
+        (isLiteral || detail::IsCapturedString<FormatT>::value) &&
+        (capturedArgsSize <= FlightRecord::DATA_CAPACITY) &&
+        (true && ... && detail::IsCapturable<Args>::value);
+
+    detail::getThreadFlightRecorder().capture([&](FlightRecord& record) {
+        record.time = FlightRecord::Clock::now();
+        record.level = level;
+        record.nameSize = std::min(moduleName.size(), FlightRecord::NAME_CAPACITY);
+        std::memcpy(record.name, moduleName.data(), record.nameSize);
+        if constexpr (useCapturedArgs) {
+            const std::string_view formatText(detail::toFormat(format));
+            if (isLiteral || (formatText.size() <= FlightRecord::DATA_CAPACITY - capturedArgsSize)) {
+                // -- BINARY FORM: Format string (pointer or bytes) and captured args.
+                [[maybe_unused]] std::size_t argOffset = 0;
+                [[maybe_unused]] std::size_t stringOffset = capturedArgsSize;
+                if constexpr (isLiteral) {
+                    record.format = format.format;
+                } else {
+                    std::memcpy(record.data + stringOffset, formatText.data(), formatText.size());
+                    stringOffset += formatText.size();
+                    record.format = nullptr;
+                }
+                record.formatSize = formatText.size();
+                (detail::writeArg(record, argOffset, detail::captureArg(args, record, stringOffset)), ...);
+                record.render = &detail::renderCapturedArgs<FormatterT, Args...>;
+                return;
+            }
+        }
+        // -- SLOW PATH: Format now (text is truncated).
+        std::string text;
+        FormatterT::format(text, detail::toFormat(format), args...);
+        const auto size = std::min(text.size(), FlightRecord::DATA_CAPACITY - 1);
+        std::memcpy(record.data, text.data(), size);
+        record.data[size] = '\0';
+        record.format = nullptr;
+        record.formatSize = 0;
+        record.render = &detail::renderText;
+    });
+    ++detail::flightRecordCount;
+}
+
+/**
+ * Dumps (and removes) the captured records of the current thread.
+ * @param func  Called with (const FlightRecord&, const std::string& text)
+ *              for each record (oldest first).
+ **/
+template<typename FuncT>
+inline void dumpFlightRecorder(const FuncT& func)
+{
+    detail::flightRecordCount = 0;
+    const auto records = detail::getThreadFlightRecorder().takeRecords();
+    for (const auto& record : records) {
+        func(record, record.getText());
+    }
+}
+
+//! Dumps (and removes) the captured records of all threads.
+template<typename FuncT>
+inline void dumpAllFlightRecorders(const FuncT& func)
+{
+    std::vector<FlightRecorderPtr> recorders;
+    {
+        auto& registry = detail::getFlightRecorderRegistry();
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        recorders = registry.recorders;
+    }
+    for (const auto& recorder : recorders) {
+        for (const auto& record : recorder->takeRecords()) {
+            func(record, record.getText());
+        }
+    }
+}
+
+}} //< NAMESPACE-END: simplelog::backend_common
@@ -0,0 +1,179 @@
+/**
+ * @file simplelog/backend/common/LevelConfig.hpp
+ * Simplelog common backend description of a level/sink configuration.
+ *
+ * A LevelConfig is read from a simple text file (one entry per line):
+ *
+ * @code
+ *  # SCHEMA: <module_pattern> = <level> [: <sink_name>, ...]
+ *  *           = warn
+ *  foo.*       = debug
+ *  db.query    = info : console, file
+ * @endcode
+ *
+ * The module pattern is a module name, a name prefix ending in "*" or "*".
+ * Entries are applied in order (later entries override earlier ones).
+ * Level names are the same for all backends (see: parseLevelSeverity()).
+ * Sink names are interpreted by each backend.
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <cctype>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+// --------------------------------------------------------------------------
+// LOGGING LEVEL CONFIGURATION
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_common {
+
+/**
+ * @struct LevelConfigEntry
+ * Assigns a level (and optionally sinks) to all modules matching the pattern.
+ **/
+struct LevelConfigEntry
+{
+    std::string pattern;
+    std::string level;
+    std::vector<std::string> sinkNames;  //< EMPTY: Keep sinks of module.
+};
+using LevelConfig = std::vector<LevelConfigEntry>;
+
+/**
+ * Checks if a module name matches a pattern.
+ * @param pattern  Module name, prefix with trailing "*" (as: "foo.*") or "*".
+ * @param name     Module name to check.
+ * @return true, if the name matches the pattern.
+ **/
+inline bool matchesModulePattern(std::string_view pattern, std::string_view name)
+{
+    if (!pattern.empty() && (pattern.back() == '*')) {
+        pattern.remove_suffix(1);
+        return name.substr(0, pattern.size()) == pattern;
+    }
+    return name == pattern;
+}
+
+/**
+ * @enum LevelSeverity
+ * Backend independent severity of a level name (as in a LevelConfig).
+ * Each backend maps it to its own level.
+ **/
+enum class LevelSeverity
+{
+    Trace, Debug, Info, Notice, Warning, Error, Critical, Alert, Emergency, Off
+};
+
+/**
+ * Converts a level name into a LevelSeverity.
+ * The level names are the same for all backends:
+ * trace, debug, info, notice, warn, warning, err, error, crit, critical,
+ * alert, emerg, fatal, off.
+ * @return true, if the level name is known. Otherwise, false.
+ **/
+inline bool parseLevelSeverity(std::string_view name, LevelSeverity& severity)
+{
+    struct LevelName { std::string_view name; LevelSeverity severity; };
+    static constexpr LevelName levelNames[] = {
+        {"trace", LevelSeverity::Trace},        {"debug", LevelSeverity::Debug},
+        {"info", LevelSeverity::Info},          {"notice", LevelSeverity::Notice},
+        {"warn", LevelSeverity::Warning},       {"warning", LevelSeverity::Warning},
+        {"err", LevelSeverity::Error},          {"error", LevelSeverity::Error},
+        {"crit", LevelSeverity::Critical},      {"critical", LevelSeverity::Critical},
+        {"alert", LevelSeverity::Alert},        {"emerg", LevelSeverity::Emergency},
+        {"fatal", LevelSeverity::Emergency},    {"off", LevelSeverity::Off}
+    };
+    for (const auto& levelName : levelNames) {
+        if (levelName.name == name) {
+            severity = levelName.severity;
+            return true;
+        }
+    }
+    return false;
+}
+
+namespace detail {
+
+inline std::string_view trimmed(std::string_view text)
+{
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+inline std::vector<std::string> splitNames(std::string_view text)
+{
+    std::vector<std::string> names;
+    while (!text.empty()) {
+        const auto pos = text.find(',');
+        const auto name = trimmed(text.substr(0, pos));
+        if (!name.empty()) {
+            names.emplace_back(name);
+        }
+        if (pos == std::string_view::npos) {
+            break;
+        }
+        text.remove_prefix(pos + 1);
+    }
+    return names;
+}
+
+} //< NAMESPACE-END: detail
+
+/**
+ * Parses a LevelConfig from a text stream.
+ * Empty lines and comment lines (starting with '#') are ignored.
+ * Lines without '=' or without level are ignored (as invalid lines).
+ **/
+inline LevelConfig parseLevelConfig(std::istream& input)
+{
+    LevelConfig config;
+    std::string line;
+    while (std::getline(input, line)) {
+        const auto text = detail::trimmed(line);
+        const auto equalPos = text.find('=');
+        if (text.empty() || (text.front() == '#') || (equalPos == std::string_view::npos)) {
+            continue;
+        }
+
+        LevelConfigEntry entry;
+        auto value = text.substr(equalPos + 1);
+        const auto colonPos = value.find(':');
+        if (colonPos != std::string_view::npos) {
+            entry.sinkNames = detail::splitNames(value.substr(colonPos + 1));
+            value = value.substr(0, colonPos);
+        }
+        entry.pattern = std::string(detail::trimmed(text.substr(0, equalPos)));
+        entry.level = std::string(detail::trimmed(value));
+        if (entry.pattern.empty() || entry.level.empty()) {
+            continue;
+        }
+        config.push_back(std::move(entry));
+    }
+    return config;
+}
+
+/**
+ * Reads a LevelConfig from a file.
+ * @return LevelConfig (or empty LevelConfig, if the file could not be read).
+ **/
+inline LevelConfig readLevelConfigFile(const std::string& filename)
+{
+    std::ifstream input(filename);
+    if (!input) {
+        return LevelConfig();
+    }
+    return parseLevelConfig(input);
+}
+
+}} //< NAMESPACE-END: simplelog::backend_common
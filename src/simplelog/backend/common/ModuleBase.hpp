@@ -11,7 +11,15 @@
 #pragma once
 
 // -- INCLUDES:
+#include "simplelog/backend/common/ModuleTable.hpp"
+#include "simplelog/backend/common/RateLimitBudget.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 
 // --------------------------------------------------------------------------
@@ -19,28 +27,171 @@
 // --------------------------------------------------------------------------
 namespace simplelog { namespace backend_common {
 
+class ModuleBase;
+
+namespace detail {
+
+/**
+ * @struct BudgetSummaryQueue
+ * Modules that dropped log-records (over budget) and still owe the summary.
+ **/
+struct BudgetSummaryQueue
+{
+    std::mutex mutex;
+    std::vector<ModuleBase*> modules;
+    std::atomic<bool> hasModules{false};    //< FAST PATH: Checked without lock.
+};
+
+/**
+ * Provides the queue (that is never destroyed).
+ * @note A static ModuleRegistry may be destroyed after this queue would be
+ *       (static destruction order). Its modules still use the queue then.
+ **/
+inline BudgetSummaryQueue& getBudgetSummaryQueue()
+{
+    static auto* theQueue = new BudgetSummaryQueue();   //< NEVER DESTROYED.
+    return *theQueue;
+}
+
+} //< NAMESPACE-END: detail
+
 /**
  * @class ModuleBase
  * Provides a named logging module (logger) to log to systemd-journal.
  * Provides an thin adapter around the systemd-journal API.
+ *
+ * @note The hot data (level, flags, counter) is stored in the ModuleTable
+ *       of the ModuleRegistry (as ModuleSlot). The module owns only the name.
+ * @note Each level change of a module goes through setLevel().
+ *       A backend is notified with onLevelChanged() (as: syslog log mask).
+ * @note RATE-LIMIT: A module that dropped log-records is queued.
+ *       Its summary is sent with the next log-record of any module
+ *       (after its window ended) or with flushBudgetSummaries().
  **/
 class ModuleBase
 {
 private:
     std::string m_name;
-    int m_level;    //!< Log level as threshold to suppress messages.
+    ModuleId m_id;
+    ModuleSlot m_slot;  //!< Level as threshold to suppress messages, ...
+    RateLimitBudget m_budget;
+    std::atomic<bool> m_hasBudgetSummary;   //< Is in the BudgetSummaryQueue.
 
 public:
-    explicit ModuleBase(std::string name="")
-        : m_name(std::move(name)), m_level(0)
-    {}
-    explicit ModuleBase(std::string name, int level=0)
-        : m_name(std::move(name)), m_level(level)
+    ModuleBase(std::string name, ModuleId id, ModuleSlot slot)
+        : m_name(std::move(name)), m_id(id), m_slot(slot), m_budget(),
+          m_hasBudgetSummary(false)
     {}
+    virtual ~ModuleBase()
+    {
+        if (m_hasBudgetSummary.load()) {
+            auto& queue = detail::getBudgetSummaryQueue();
+            // -- CRITICAL-SECTION
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            auto& modules = queue.modules;
+            modules.erase(std::remove(modules.begin(), modules.end(), this), modules.end());
+            queue.hasModules.store(!modules.empty(), std::memory_order_relaxed);
+        }
+    }
+    ModuleBase(const ModuleBase&) = delete;
+    ModuleBase& operator=(const ModuleBase&) = delete;
 
     const std::string& getName(void) const { return m_name; }
-    int getLevel(void) const { return m_level; }
-    void setLevel(int level) { m_level = level; }
+    ModuleId getId(void) const { return m_id; }
+    int getLevel(void) const { return m_slot.getLevel(); }
+    void setLevel(int level)
+    {
+        m_slot.setLevel(level);
+        onLevelChanged(level);
+    }
+
+    std::uint32_t getFlags(void) const { return m_slot.getFlags(); }
+    void setFlags(std::uint32_t value) { m_slot.setFlags(value); }
+
+    //! Number of log records that were emitted by this module.
+    std::uint64_t getCounter(void) const { return m_slot.getCounter(); }
+    void resetCounter(void) { m_slot.resetCounter(); }
+
+    //! Number of log records that were dropped by the rate-limit budget.
+    std::uint64_t getDroppedByBudgetCount(void) const { return m_budget.getDroppedCount(); }
+
+    /**
+     * Sends the summary of each queued module whose budget window ended.
+     * @note Called by each log-record within the budget (of any module).
+     *       Call it from a timer, too, if the modules may stop logging.
+     **/
+    static void flushBudgetSummaries(void)
+    {
+        auto& queue = detail::getBudgetSummaryQueue();
+        if (!queue.hasModules.load(std::memory_order_relaxed)) {
+            return;
+        }
+        std::vector<std::pair<ModuleBase*, std::uint64_t>> summaries;
+        {
+            // -- CRITICAL-SECTION
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            auto& modules = queue.modules;
+            modules.erase(std::remove_if(modules.begin(), modules.end(), [&](ModuleBase* module) {
+                std::uint64_t droppedCount;
+                if (!module->m_budget.tryStartWindow(droppedCount)) {
+                    return false;   //< WINDOW NOT ENDED: May drop more.
+                }
+                module->m_hasBudgetSummary.store(false);
+                if (droppedCount > 0) {
+                    summaries.emplace_back(module, droppedCount);
+                }
+                return true;
+            }), modules.end());
+            queue.hasModules.store(!modules.empty(), std::memory_order_relaxed);
+        }
+        for (const auto& summary : summaries) {
+            summary.first->sendBudgetSummary(summary.second);
+        }
+    }
+
+protected:
+    //! Called after the level was changed (by any caller of setLevel()).
+    virtual void onLevelChanged(int /* level */) {}
+
+    //! Sends the summary log-record: Number of log-records dropped by the budget.
+    virtual void sendBudgetSummary(std::uint64_t /* droppedCount */) {}
+
+    void countRecord(void) { m_slot.incrementCounter(); }
+
+    /**
+     * Checks the rate-limit budget of this module (if enabled).
+     * Sends the summaries that are due (of this module and queued modules).
+     **/
+    bool isWithinBudget(void)
+    {
+        if (!isRateLimitEnabled()) {
+            return true;
+        }
+        std::uint64_t droppedCount;
+        const bool withinBudget = m_budget.tryAcquire(droppedCount);
+        if (droppedCount > 0) {
+            sendBudgetSummary(droppedCount);
+        }
+        if (!withinBudget) {
+            enqueueBudgetSummary();
+            return false;
+        }
+        flushBudgetSummaries();
+        return true;
+    }
+
+private:
+    void enqueueBudgetSummary(void)
+    {
+        if (m_hasBudgetSummary.exchange(true)) {
+            return;     //< ALREADY QUEUED.
+        }
+        auto& queue = detail::getBudgetSummaryQueue();
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.modules.push_back(this);
+        queue.hasModules.store(true, std::memory_order_relaxed);
+    }
 };
 
 }} //< NAMESPACE-END: simplelog::backend_common
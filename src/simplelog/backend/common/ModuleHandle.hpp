@@ -0,0 +1,52 @@
+/**
+ * @file simplelog/backend/common/ModuleHandle.hpp
+ * Simplelog common backend handle to a module in a ModuleRegistry.
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include "simplelog/backend/common/ModuleTable.hpp"
+#include <cstddef>
+
+
+// --------------------------------------------------------------------------
+// LOGGING MODULE HANDLE
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_common {
+
+/**
+ * @class ModuleHandle
+ * Lightweight, copyable handle to a module that is owned by a ModuleRegistry.
+ * Behaves like a pointer (but without reference counting).
+ *
+ * @note The module is owned by the registry and has a stable address.
+ *       The handle stays valid until the ModuleRegistry is destroyed
+ *       (a module that is removed by ModuleRegistry::clear() is retired).
+ **/
+template<typename Module>
+class ModuleHandle
+{
+private:
+    Module* m_module;
+
+public:
+    ModuleHandle() : m_module(nullptr) {}
+    ModuleHandle(std::nullptr_t) : m_module(nullptr) {}
+    explicit ModuleHandle(Module* module) : m_module(module) {}
+
+    Module* get() const { return m_module; }
+    Module* operator->() const { return m_module; }
+    Module& operator*() const { return *m_module; }
+    explicit operator bool() const { return m_module != nullptr; }
+
+    ModuleId getId() const
+    {
+        return m_module ? m_module->getId() : INVALID_MODULE_ID;
+    }
+
+    bool operator==(const ModuleHandle& other) const { return m_module == other.m_module; }
+    bool operator!=(const ModuleHandle& other) const { return m_module != other.m_module; }
+};
+
+}} //< NAMESPACE-END: simplelog::backend_common
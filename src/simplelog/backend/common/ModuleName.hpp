@@ -0,0 +1,100 @@
+/**
+ * @file simplelog/backend/common/ModuleName.hpp
+ * Simplelog common backend key type for module lookups.
+ *
+ * A ModuleName is a non-owning view of a module name with its hash.
+ * The hash of a string literal is computed at compile-time (constexpr).
+ * A lookup with a ModuleName needs no std::string (no allocation).
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>  //< USE: std::integral_constant
+
+
+// --------------------------------------------------------------------------
+// LOGGING MODULE NAME
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_common {
+
+/**
+ * Computes the FNV-1a hash of a module name.
+ * @see http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ **/
+constexpr std::uint64_t hashModuleName(std::string_view name)
+{
+    std::uint64_t hash = 14695981039346656037ULL;   //< FNV_OFFSET_BASIS
+    for (const char c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;                   //< FNV_PRIME
+    }
+    return hash;
+}
+
+/**
+ * @class ModuleName
+ * Module name (as string_view) with precomputed hash.
+ * @note Only a view: The referenced characters must outlive the ModuleName.
+ **/
+class ModuleName
+{
+private:
+    std::string_view m_name;
+    std::uint64_t m_hash;
+
+public:
+    constexpr ModuleName(const char* name)
+        : m_name(name), m_hash(hashModuleName(m_name))
+    {}
+    constexpr ModuleName(std::string_view name)
+        : m_name(name), m_hash(hashModuleName(name))
+    {}
+    ModuleName(const std::string& name)
+        : m_name(name), m_hash(hashModuleName(m_name))
+    {}
+    constexpr ModuleName(std::string_view name, std::uint64_t hash)
+        : m_name(name), m_hash(hash)
+    {}
+
+    constexpr std::string_view getName() const { return m_name; }
+    constexpr std::uint64_t getHash() const { return m_hash; }
+    std::string toString() const { return std::string(m_name); }
+
+    constexpr bool operator==(const ModuleName& other) const
+    {
+        return (m_hash == other.m_hash) && (m_name == other.m_name);
+    }
+    constexpr bool operator!=(const ModuleName& other) const
+    {
+        return !(*this == other);
+    }
+
+    //! Hash functor that reuses the precomputed hash (for unordered containers).
+    struct Hasher
+    {
+        std::size_t operator()(const ModuleName& key) const
+        {
+            return static_cast<std::size_t>(key.m_hash);
+        }
+    };
+};
+
+}} //< NAMESPACE-END: simplelog::backend_common
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND HELPER MACROS
+// --------------------------------------------------------------------------
+/**
+ * @macro SIMPLELOG_BACKEND_MODULE_NAME(name)
+ * Creates a ModuleName whose hash is computed at compile-time.
+ * @note REQUIRES: name is a string literal (or constant expression).
+ **/
+#define SIMPLELOG_BACKEND_MODULE_NAME(name) \
+    ::simplelog::backend_common::ModuleName(name, \
+        std::integral_constant<std::uint64_t, \
+            ::simplelog::backend_common::hashModuleName(name)>::value)
@@ -6,11 +6,18 @@
 #pragma once
 
 // -- INCLUDES:
+#include "simplelog/backend/common/ModuleTable.hpp"
+#include "simplelog/backend/common/ModuleHandle.hpp"
+#include "simplelog/backend/common/ModuleName.hpp"
+#include "simplelog/backend/common/LevelConfig.hpp"  //< USE: matchesModulePattern()
 #include <cassert>
 #include <string>
-#include <map>
-#include <memory>   //< USE: std::shared_ptr<T>, std::make_shared<T>()
+#include <string_view>
+#include <unordered_map>
+#include <deque>    //< USE: Stable addresses for modules.
+#include <memory>
 #include <mutex>
+#include <vector>
 
 
 // --------------------------------------------------------------------------
@@ -21,35 +28,84 @@ namespace simplelog { namespace backend_common {
 /**
  * @class ModuleRegistry
  * Provides a ModuleRegistry usable from the common cases.
+ *
+ * Each module name is interned as ModuleId (index into the module storage).
+ * Lookups use a ModuleName (string_view with precomputed hash):
+ * One hash-table probe without creating a std::string.
+ * The hot data of all modules (level, flags, counter) is stored
+ * in a dense ModuleTable (structure-of-arrays), indexed by the ModuleId.
+ * Modules are owned by the registry and never move in memory.
+ * Therefore, log-users hold a ModuleHandle (without reference counting).
+ * A new module starts with the level of its last matching LevelRule
+ * (or the default level).
  **/
 template<typename Module, typename Level=int>
 class ModuleRegistry
 {
+public:
+    using ModulePtr = ModuleHandle<Module>;
+
+    //! Level of the new modules whose name matches the pattern (as: "db.*").
+    struct LevelRule
+    {
+        std::string pattern;
+        Level level;
+    };
+    using LevelRules = std::vector<LevelRule>;
+
 private:
-    using ModulePtr = std::shared_ptr<Module>;
-    using ModuleMap = std::map<std::string, ModulePtr>;
-    ModuleMap m_moduleMap;
+    //! KEY: ModuleName views the name that is owned by the module.
+    using ModuleIdMap = std::unordered_map<ModuleName, ModuleId, ModuleName::Hasher>;
+    using Modules = std::deque<Module>;
+    using ModulesPtr = std::unique_ptr<Modules>;
+    ModuleIdMap m_moduleIdMap;
+    Modules     m_modules;      //< Indexed by: ModuleId
+    ModuleTable m_moduleTable;  //< Indexed by: ModuleId
+    std::vector<ModulesPtr> m_retiredModules;   //< Used by handles of cleared modules.
+    LevelRules m_levelRules;    //< Later rules override earlier ones.
     Level m_defaultLevel;
     mutable std::mutex m_mutex;
 
 protected:
     // -- INTERNAL METHODS: Assume multi-threading locked state.
-    inline bool hasModule_(const std::string& name) const
+    inline bool hasModule_(const ModuleName& name) const
+    {
+        return m_moduleIdMap.find(name) != m_moduleIdMap.end();
+    }
+
+    inline ModulePtr getModule_(ModuleId id)
+    {
+        assert(id < m_modules.size());
+        return ModulePtr(&m_modules[id]);
+    }
+
+    inline Level getLevelOfNewModule_(std::string_view name) const
     {
-        return m_moduleMap.find(name) != m_moduleMap.end();
+        Level level = getDefaultLevel();
+        for (const auto& rule : m_levelRules) {
+            if (matchesModulePattern(rule.pattern, name)) {
+                level = rule.level;
+            }
+        }
+        return level;
     }
 
-    inline ModulePtr addModule_(const std::string& name)
+    inline ModulePtr addModule_(const ModuleName& name)
     {
         assert(not hasModule_(name));
-        auto newModulePtr = std::make_shared<Module>(name, getDefaultLevel());
-        m_moduleMap.emplace(std::make_pair(name, newModulePtr));
-        return newModulePtr;
+        const auto newLevel = getLevelOfNewModule_(name.getName());
+        const auto newId = m_moduleTable.addSlot(static_cast<int>(newLevel));
+        m_modules.emplace_back(name.toString(), newId, m_moduleTable.getSlot(newId));
+        const auto key = ModuleName(m_modules.back().getName(), name.getHash());
+        m_moduleIdMap.emplace(key, newId);
+        assert(m_modules.size() == m_moduleTable.size());
+        return getModule_(newId);
     }
 
 public:
     ModuleRegistry()
-        : m_moduleMap(), m_defaultLevel(), m_mutex()
+        : m_moduleIdMap(), m_modules(), m_moduleTable(), m_retiredModules(),
+          m_levelRules(), m_defaultLevel(), m_mutex()
     {
         // -- CRITICAL-SECTION
         const std::lock_guard<std::mutex> lock(m_mutex);
@@ -64,42 +120,91 @@ public:
     inline Level getDefaultLevel() const { return m_defaultLevel; }
     inline void setDefaultLevel(Level value) { m_defaultLevel = value; }
 
-    inline bool empty() const { return m_moduleMap.empty(); }
-    inline std::size_t size() const { return m_moduleMap.size(); }
+    //! Replaces the level rules for new modules (as: the applied LevelConfig).
+    inline void setLevelRules(LevelRules rules)
+    {
+        // -- CRITICAL-SECTION
+        const std::lock_guard<std::mutex> guard(m_mutex);
+        m_levelRules = std::move(rules);
+    }
+
+    //! Adds level rules for new modules (after the existing ones).
+    inline void addLevelRules(const LevelRules& rules)
+    {
+        // -- CRITICAL-SECTION
+        const std::lock_guard<std::mutex> guard(m_mutex);
+        m_levelRules.insert(m_levelRules.end(), rules.begin(), rules.end());
+    }
+
+    inline LevelRules getLevelRules() const
+    {
+        // -- CRITICAL-SECTION
+        const std::lock_guard<std::mutex> guard(m_mutex);
+        return m_levelRules;
+    }
+
+    inline bool empty() const { return m_modules.empty(); }
+    inline std::size_t size() const { return m_modules.size(); }
 
+    /**
+     * Removes all modules (new modules start with ModuleId=0 again).
+     * The removed modules are retired (kept alive until the registry is
+     * destroyed). Therefore, a ModuleHandle of a removed module
+     * (as: in a static variable) stays valid (but is no longer registered).
+     * @warning The ModuleId of a removed module becomes invalid.
+     **/
     inline void clear()
     {
         // -- CRITICAL-SECTION
         const std::lock_guard<std::mutex> guard(m_mutex);
-        m_moduleMap.clear();
+        m_moduleIdMap.clear();
+        auto retiredModules = std::make_unique<Modules>();
+        retiredModules->swap(m_modules);    //< HINT: swap() keeps addresses.
+        m_retiredModules.push_back(std::move(retiredModules));
+        m_moduleTable.clear();
     }
 
-    inline bool hasModule(const std::string& name) const
+    inline bool hasModule(const ModuleName& name) const
     {
         // -- CRITICAL-SECTION
         const std::lock_guard<std::mutex> guard(m_mutex);
         return hasModule_(name);
     }
 
-    inline ModulePtr useOrCreateModule(const std::string& name)
+    inline ModulePtr useOrCreateModule(const ModuleName& name)
     {
         // -- CRITICAL-SECTION
         const std::lock_guard<std::mutex> guard(m_mutex);
-        auto moduleIter = m_moduleMap.find(name);
-        if (moduleIter != m_moduleMap.end()) {
-            return moduleIter->second;
+        auto moduleIter = m_moduleIdMap.find(name);
+        if (moduleIter != m_moduleIdMap.end()) {
+            return getModule_(moduleIter->second);
         }
         return addModule_(name);
     }
 
+    inline ModuleId useOrCreateModuleId(const ModuleName& name)
+    {
+        return useOrCreateModule(name).getId();
+    }
+
+    //! Returns the module for this id (or nullptr, if the id is unknown).
+    inline ModulePtr getModuleById(ModuleId id)
+    {
+        // -- CRITICAL-SECTION
+        const std::lock_guard<std::mutex> guard(m_mutex);
+        if (id >= m_modules.size()) {
+            return ModulePtr();
+        }
+        return getModule_(id);
+    }
+
     template<typename Callable>
     inline void applyToModules(Callable func)
     {
         // -- CRITICAL-SECTION
         const std::lock_guard<std::mutex> lock(m_mutex);
-        for (auto& moduleItem : m_moduleMap) {
-            auto modulePtr = moduleItem.second;
-            func(modulePtr);
+        for (auto& module : m_modules) {
+            func(ModulePtr(&module));
         }
     }
 
@@ -108,8 +213,8 @@ public:
     {
         // -- CRITICAL-SECTION
         const std::lock_guard<std::mutex> lock(m_mutex);
-        for (auto& moduleItem : m_moduleMap) {
-            auto& modulePtr = moduleItem.second;
+        for (auto& module : m_modules) {
+            const auto modulePtr = ModulePtr(&module);
             if (predicate(modulePtr)) {
                 func(modulePtr);
             }
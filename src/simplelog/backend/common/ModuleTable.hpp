@@ -0,0 +1,175 @@
+/**
+ * @file simplelog/backend/common/ModuleTable.hpp
+ * Simplelog common backend storage for the hot data of logging modules.
+ *
+ * Each module name is interned as a small integer id (ModuleId).
+ * The hot data per module (level, flags, counter) is stored in
+ * structure-of-arrays chunks that are indexed by this id.
+ * A chunk is never moved or freed while the table exists.
+ * Therefore, a ModuleSlot (chunk, index) is a stable reference.
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>   //< USE: std::unique_ptr<T>
+#include <vector>
+
+
+// --------------------------------------------------------------------------
+// LOGGING MODULE TABLE
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_common {
+
+using ModuleId = std::uint32_t;
+constexpr ModuleId INVALID_MODULE_ID = std::numeric_limits<ModuleId>::max();
+
+/**
+ * @struct ModuleTableChunk
+ * Structure-of-arrays storage for the hot data of CHUNK_SIZE modules.
+ * Each array starts on its own cache-line.
+ * @note Counters are updated by logging threads; levels are mostly read.
+ *       Keeping them in separate arrays avoids false sharing of the levels.
+ **/
+struct ModuleTableChunk
+{
+    static constexpr std::size_t CHUNK_SIZE = 64;
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<int> levels[CHUNK_SIZE];
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> flags[CHUNK_SIZE];
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> counters[CHUNK_SIZE];
+
+    ModuleTableChunk()
+    {
+        for (std::size_t i = 0; i < CHUNK_SIZE; ++i) {
+            levels[i].store(0, std::memory_order_relaxed);
+            flags[i].store(0, std::memory_order_relaxed);
+            counters[i].store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * @class ModuleSlot
+ * Stable reference to the hot data of one module in a ModuleTable.
+ * @note All accessors are lock-free (relaxed atomics).
+ **/
+class ModuleSlot
+{
+private:
+    ModuleTableChunk* m_chunk;
+    std::uint32_t m_index;
+
+public:
+    ModuleSlot() : m_chunk(nullptr), m_index(0) {}
+    ModuleSlot(ModuleTableChunk* chunk, std::uint32_t index)
+        : m_chunk(chunk), m_index(index)
+    {
+        assert(index < ModuleTableChunk::CHUNK_SIZE);
+    }
+
+    bool isValid() const { return m_chunk != nullptr; }
+
+    int getLevel() const
+    {
+        return m_chunk->levels[m_index].load(std::memory_order_relaxed);
+    }
+    void setLevel(int level)
+    {
+        m_chunk->levels[m_index].store(level, std::memory_order_relaxed);
+    }
+
+    std::uint32_t getFlags() const
+    {
+        return m_chunk->flags[m_index].load(std::memory_order_relaxed);
+    }
+    void setFlags(std::uint32_t value)
+    {
+        m_chunk->flags[m_index].store(value, std::memory_order_relaxed);
+    }
+    void addFlags(std::uint32_t mask)
+    {
+        m_chunk->flags[m_index].fetch_or(mask, std::memory_order_relaxed);
+    }
+    void removeFlags(std::uint32_t mask)
+    {
+        m_chunk->flags[m_index].fetch_and(~mask, std::memory_order_relaxed);
+    }
+
+    std::uint64_t getCounter() const
+    {
+        return m_chunk->counters[m_index].load(std::memory_order_relaxed);
+    }
+    void incrementCounter()
+    {
+        m_chunk->counters[m_index].fetch_add(1, std::memory_order_relaxed);
+    }
+    void resetCounter()
+    {
+        m_chunk->counters[m_index].store(0, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @class ModuleTable
+ * Dense, chunked structure-of-arrays table for the hot module data.
+ * @note addSlot() is not thread-safe (caller must hold the registry lock).
+ *       Slot accessors are lock-free and may be used from any thread.
+ **/
+class ModuleTable
+{
+private:
+    using ChunkPtr = std::unique_ptr<ModuleTableChunk>;
+    std::vector<ChunkPtr> m_chunks;
+    std::vector<ChunkPtr> m_retiredChunks;  //< Used by slots of cleared modules.
+    std::size_t m_size;
+
+public:
+    ModuleTable() : m_chunks(), m_retiredChunks(), m_size(0) {}
+    ModuleTable(const ModuleTable&) = delete;
+    ModuleTable& operator=(const ModuleTable&) = delete;
+
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    ModuleSlot getSlot(ModuleId id) const
+    {
+        assert(id < m_size);
+        const auto chunkIndex = id / ModuleTableChunk::CHUNK_SIZE;
+        const auto index = id % ModuleTableChunk::CHUNK_SIZE;
+        return ModuleSlot(m_chunks[chunkIndex].get(), static_cast<std::uint32_t>(index));
+    }
+
+    //! Adds a new slot (with initial level) and returns its ModuleId.
+    ModuleId addSlot(int level)
+    {
+        const auto id = static_cast<ModuleId>(m_size);
+        if ((m_size % ModuleTableChunk::CHUNK_SIZE) == 0) {
+            m_chunks.emplace_back(new ModuleTableChunk());
+        }
+        ++m_size;
+        getSlot(id).setLevel(level);
+        return id;
+    }
+
+    /**
+     * Removes all slots (new slots start with ModuleId=0 again).
+     * @note The chunks are retired (not freed): Any ModuleSlot stays valid.
+     **/
+    void clear()
+    {
+        for (auto& chunk : m_chunks) {
+            m_retiredChunks.push_back(std::move(chunk));
+        }
+        m_chunks.clear();
+        m_size = 0;
+    }
+};
+
+}} //< NAMESPACE-END: simplelog::backend_common
@@ -0,0 +1,135 @@
+/**
+ * @file simplelog/backend/common/RateLimitBudget.hpp
+ * Simplelog common backend rate-limit budget (per module).
+ *
+ * journald drops log-records silently if a service exceeds its rate limit
+ * (RateLimitIntervalSec=, RateLimitBurst=). With a configured budget,
+ * each module sends at most "burst" log-records per interval.
+ * Over-budget log-records are dropped before they are formatted and sent.
+ * The next interval starts with a summary log-record per module:
+ * "N log-records dropped by simplelog budget (module: NAME)".
+ * It is sent with the next log-record of any module (see: ModuleBase).
+ *
+ * @code
+ *  // -- MIRROR: journald defaults (RateLimitIntervalSec=30s, RateLimitBurst=10000).
+ *  simplelog::backend_common::setRateLimit(std::chrono::seconds(30), 10000);
+ * @endcode
+ *
+ * FAST PATH: If disabled, one relaxed atomic read per enabled log-record.
+ * @note The journald limit applies to the whole service:
+ *       Use a module burst below it if many modules log a lot.
+ * @see https://www.freedesktop.org/software/systemd/man/journald.conf.html
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+
+// --------------------------------------------------------------------------
+// LOGGING RATE-LIMIT BUDGET
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_common {
+
+namespace detail {
+
+inline std::atomic<std::uint32_t> rateLimitBurst(0);    //< 0: Disabled.
+inline std::atomic<std::int64_t> rateLimitIntervalInNanos(30000000000LL);
+
+inline std::int64_t getSteadyTimeInNanos()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} //< NAMESPACE-END: detail
+
+/**
+ * Sets the budget of each module: Max. burst log-records per interval.
+ * @param burst  Max. number of log-records (or 0: Disables the rate limit).
+ **/
+inline void setRateLimit(std::chrono::nanoseconds interval, std::uint32_t burst)
+{
+    detail::rateLimitIntervalInNanos.store(interval.count(), std::memory_order_relaxed);
+    detail::rateLimitBurst.store(burst, std::memory_order_relaxed);
+}
+
+inline void disableRateLimit()
+{
+    detail::rateLimitBurst.store(0, std::memory_order_relaxed);
+}
+
+inline bool isRateLimitEnabled()
+{
+    return detail::rateLimitBurst.load(std::memory_order_relaxed) != 0;
+}
+
+/**
+ * @class RateLimitBudget
+ * Budget of one module (fixed window: burst log-records per interval).
+ * @note Lock-free: Concurrent loggers may exceed the burst slightly
+ *       when the window starts (same as journald).
+ **/
+class RateLimitBudget
+{
+private:
+    std::atomic<std::int64_t> m_windowStart;    //< Steady time (in nanoseconds).
+    std::atomic<std::uint32_t> m_count;         //< Log-records in this window.
+    std::atomic<std::uint64_t> m_dropped;       //< Dropped in this window.
+    std::atomic<std::uint64_t> m_droppedTotal;
+
+public:
+    RateLimitBudget()
+        : m_windowStart(detail::getSteadyTimeInNanos()),
+          m_count(0), m_dropped(0), m_droppedTotal(0)
+    {}
+    RateLimitBudget(const RateLimitBudget&) = delete;
+    RateLimitBudget& operator=(const RateLimitBudget&) = delete;
+
+    //! Number of log-records that were dropped (since start).
+    std::uint64_t getDroppedCount() const { return m_droppedTotal.load(std::memory_order_relaxed); }
+
+    /**
+     * Takes one log-record from the budget.
+     * @param droppedCount  Number of log-records dropped in the previous window
+     *                      (or 0). The caller sends the summary log-record.
+     * @return true, if the log-record is within the budget. Otherwise, false.
+     **/
+    bool tryAcquire(std::uint64_t& droppedCount)
+    {
+        const auto burst = detail::rateLimitBurst.load(std::memory_order_relaxed);
+        tryStartWindow(droppedCount);
+        if (m_count.fetch_add(1, std::memory_order_relaxed) < burst) {
+            return true;
+        }
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        m_droppedTotal.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * Starts a new window (if the current one ended).
+     * @param droppedCount  Number of log-records dropped in the ended window (or 0).
+     * @return true, if a new window was started. Otherwise, false.
+     **/
+    bool tryStartWindow(std::uint64_t& droppedCount)
+    {
+        droppedCount = 0;
+        const auto interval = detail::rateLimitIntervalInNanos.load(std::memory_order_relaxed);
+        const auto now = detail::getSteadyTimeInNanos();
+        auto windowStart = m_windowStart.load(std::memory_order_relaxed);
+        if ((now - windowStart >= interval) &&
+            m_windowStart.compare_exchange_strong(windowStart, now, std::memory_order_relaxed)) {
+            // -- NEW WINDOW: Only one thread resets the counters.
+            m_count.store(0, std::memory_order_relaxed);
+            droppedCount = m_dropped.exchange(0, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+};
+
+}} //< NAMESPACE-END: simplelog::backend_common
@@ -0,0 +1,107 @@
+/**
+ * @file simplelog/backend/common/ThreadLevelOverride.hpp
+ * Simplelog common backend per-thread level overrides (RAII scope).
+ *
+ * Raises the verbosity of some modules for the current thread only,
+ * like: All modules "db.*" use level=DEBUG while one request is processed.
+ *
+ * @code
+ *  void handleRequest(const Request& request)
+ *  {
+ *      using simplelog::backend_common::ThreadLevelOverrideScope;
+ *      std::optional<ThreadLevelOverrideScope> verboseScope;
+ *      if (request.isFlagged()) {
+ *          verboseScope.emplace("db.*", SIMPLELOG_BACKEND_LEVEL_DEBUG);
+ *      }
+ *      ...     // -- LOG-RECORDS of this thread: Use level=DEBUG for "db.*".
+ *  }
+ * @endcode
+ *
+ * FAST PATH: A thread without overrides reads only one thread_local counter
+ * (and only for records that are disabled by the module level).
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include "simplelog/backend/common/LevelConfig.hpp"  //< USE: matchesModulePattern()
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+// --------------------------------------------------------------------------
+// LOGGING THREAD LEVEL OVERRIDES
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_common {
+
+struct ThreadLevelOverride
+{
+    std::string pattern;    //< Module pattern (as: "db.*")
+    int level;              //< Backend level (as: SIMPLELOG_BACKEND_LEVEL_DEBUG)
+};
+
+namespace detail {
+
+//! Number of active overrides of this thread (trivial: No TLS init guard).
+inline thread_local std::size_t threadLevelOverrideCount = 0;
+
+inline std::vector<ThreadLevelOverride>& threadLevelOverrides()
+{
+    thread_local std::vector<ThreadLevelOverride> theOverrides;
+    return theOverrides;
+}
+
+} //< NAMESPACE-END: detail
+
+//! Indicates if the current thread has any level overrides (FAST PATH).
+inline bool hasThreadLevelOverrides()
+{
+    return detail::threadLevelOverrideCount != 0;
+}
+
+/**
+ * Finds the level override of the current thread for this module.
+ * The innermost (newest) matching override is used.
+ * @return true, if an override exists (level is assigned). Otherwise, false.
+ **/
+inline bool findThreadLevelOverride(std::string_view moduleName, int& level)
+{
+    if (!hasThreadLevelOverrides()) {
+        return false;
+    }
+    const auto& overrides = detail::threadLevelOverrides();
+    for (auto iter = overrides.rbegin(); iter != overrides.rend(); ++iter) {
+        if (matchesModulePattern(iter->pattern, moduleName)) {
+            level = iter->level;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @class ThreadLevelOverrideScope
+ * RAII scope: Overrides the level of matching modules for the current thread.
+ * @note The override can only enable more log-records (never disables any).
+ *       A log-record is enabled by the module level OR by the override.
+ **/
+class ThreadLevelOverrideScope
+{
+public:
+    ThreadLevelOverrideScope(std::string pattern, int level)
+    {
+        detail::threadLevelOverrides().push_back({std::move(pattern), level});
+        ++detail::threadLevelOverrideCount;
+    }
+    ~ThreadLevelOverrideScope()
+    {
+        detail::threadLevelOverrides().pop_back();
+        --detail::threadLevelOverrideCount;
+    }
+    ThreadLevelOverrideScope(const ThreadLevelOverrideScope&) = delete;
+    ThreadLevelOverrideScope& operator=(const ThreadLevelOverrideScope&) = delete;
+};
+
+}} //< NAMESPACE-END: simplelog::backend_common
@@ -0,0 +1,174 @@
+/**
+ * @file simplelog/backend/spdlog/CachedPrefixFormatter.hpp
+ * Provides a spdlog formatter that caches the rendered log-record prefix.
+ *
+ * The output is the same as for the default spdlog pattern "%+":
+ *
+ *  "[%Y-%m-%d %H:%M:%S.%e] [%n] [%^%l%$] [%s:%#] %v"
+ *
+ * The logger name part is omitted for an empty name, the source location
+ * part if the log-record has none (same as spdlog). The level name is the
+ * color range (used by color sinks).
+ * But the date-time part is only rendered once per second
+ * (only the milliseconds digits are patched for each log-record).
+ * The "[name] [level" part is only rendered if name or level changes.
+ *
+ * @code
+ *  simplelog::backend_spdlog::setCachedPrefixFormatter();
+ * @endcode
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <spdlog/spdlog.h>
+#include <spdlog/formatter.h>
+#include <spdlog/details/os.h>
+#include <spdlog/pattern_formatter.h>
+#include <spdlog/fmt/fmt.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND: CACHED PREFIX FORMATTER
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_spdlog {
+
+/**
+ * @class CachedPrefixFormatter
+ * Formatter for the default spdlog pattern "%+"
+ * with cached date-time, logger name and level.
+ *
+ * @note A formatter is used by one sink (and under its lock).
+ **/
+class CachedPrefixFormatter : public ::spdlog::formatter
+{
+public:
+    using TimeType = ::spdlog::pattern_time_type;
+
+private:
+    static constexpr std::size_t TIME_PREFIX_SIZE = 26;   //< "[2024-01-31 23:59:59.999] "
+    static constexpr std::size_t MILLIS_POS = 21;
+
+    TimeType m_timeType;
+    std::string m_eol;
+    std::chrono::seconds m_cachedSeconds;
+    char m_timePrefix[TIME_PREFIX_SIZE + 1];
+    std::string m_cachedName;
+    ::spdlog::level::level_enum m_cachedLevel;
+    std::string m_nameAndLevel;     //< "[name] [level" (or: "[level")
+    std::size_t m_levelPos;         //< Of level name in m_nameAndLevel.
+    bool m_hasNameAndLevel;
+
+public:
+    explicit CachedPrefixFormatter(TimeType timeType = TimeType::local,
+                                   std::string eol = ::spdlog::details::os::default_eol)
+        : m_timeType(timeType),
+          m_eol(std::move(eol)),
+          m_cachedSeconds(-1),
+          m_timePrefix(),
+          m_cachedName(),
+          m_cachedLevel(::spdlog::level::off),
+          m_nameAndLevel(),
+          m_levelPos(0),
+          m_hasNameAndLevel(false)
+    {}
+
+    void format(const ::spdlog::details::log_msg& msg, ::spdlog::memory_buf_t& dest) override
+    {
+        using std::chrono::duration_cast;
+        const auto sinceEpoch = msg.time.time_since_epoch();
+        const auto seconds = duration_cast<std::chrono::seconds>(sinceEpoch);
+        if (seconds != m_cachedSeconds) {
+            renderDateTime(std::chrono::system_clock::to_time_t(msg.time));
+            m_cachedSeconds = seconds;
+        }
+        const auto millis = static_cast<int>(
+            duration_cast<std::chrono::milliseconds>(sinceEpoch - seconds).count());
+        m_timePrefix[MILLIS_POS]     = static_cast<char>('0' + (millis / 100));
+        m_timePrefix[MILLIS_POS + 1] = static_cast<char>('0' + (millis / 10) % 10);
+        m_timePrefix[MILLIS_POS + 2] = static_cast<char>('0' + (millis % 10));
+        dest.append(m_timePrefix, m_timePrefix + TIME_PREFIX_SIZE);
+
+        if (!m_hasNameAndLevel || (msg.level != m_cachedLevel) ||
+            (::spdlog::string_view_t(m_cachedName) != msg.logger_name)) {
+            renderNameAndLevel(msg);
+        }
+        // -- COLOR RANGE: Level name (as: "%^%l%$").
+        msg.color_range_start = dest.size() + m_levelPos;
+        dest.append(m_nameAndLevel.data(), m_nameAndLevel.data() + m_nameAndLevel.size());
+        msg.color_range_end = dest.size();
+        dest.push_back(']');
+        dest.push_back(' ');
+        if (!msg.source.empty()) {
+            appendSourceLocation(msg.source, dest);
+        }
+        dest.append(msg.payload.data(), msg.payload.data() + msg.payload.size());
+        dest.append(m_eol.data(), m_eol.data() + m_eol.size());
+    }
+
+    std::unique_ptr<::spdlog::formatter> clone() const override
+    {
+        return std::make_unique<CachedPrefixFormatter>(m_timeType, m_eol);
+    }
+
+private:
+    void renderDateTime(std::time_t time)
+    {
+        const std::tm tm = (m_timeType == TimeType::local) ?
+            ::spdlog::details::os::localtime(time) : ::spdlog::details::os::gmtime(time);
+        char buffer[64];    //< HINT: Large enough for any int values (no truncation).
+        std::snprintf(buffer, sizeof(buffer),
+            "[%04d-%02d-%02d %02d:%02d:%02d.000] ",
+            tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+            tm.tm_hour, tm.tm_min, tm.tm_sec);
+        std::memcpy(m_timePrefix, buffer, TIME_PREFIX_SIZE);
+    }
+
+    void renderNameAndLevel(const ::spdlog::details::log_msg& msg)
+    {
+        const auto levelName = ::spdlog::level::to_string_view(msg.level);
+        m_cachedName.assign(msg.logger_name.data(), msg.logger_name.size());
+        m_cachedLevel = msg.level;
+        m_nameAndLevel = m_cachedName.empty() ? "[" : "[" + m_cachedName + "] [";
+        m_levelPos = m_nameAndLevel.size();
+        m_nameAndLevel.append(levelName.data(), levelName.size());
+        m_hasNameAndLevel = true;
+    }
+
+    static void appendSourceLocation(const ::spdlog::source_loc& source,
+                                     ::spdlog::memory_buf_t& dest)
+    {
+        const char* slash = std::strrchr(source.filename, '/');
+        const char* basename = slash ? (slash + 1) : source.filename;
+        const fmt::format_int line(source.line);
+        dest.push_back('[');
+        dest.append(basename, basename + std::strlen(basename));
+        dest.push_back(':');
+        dest.append(line.data(), line.data() + line.size());
+        dest.push_back(']');
+        dest.push_back(' ');
+    }
+};
+
+/**
+ * Creates the formatter for a pattern:
+ * The CachedPrefixFormatter for the default pattern "%+".
+ * OTHERWISE: A spdlog::pattern_formatter.
+ **/
+inline std::unique_ptr<::spdlog::formatter>
+makeCachedPrefixFormatter(const std::string& pattern,
+                          ::spdlog::pattern_time_type timeType = ::spdlog::pattern_time_type::local)
+{
+    if (pattern == "%+") {
+        return std::make_unique<CachedPrefixFormatter>(timeType);
+    }
+    return std::make_unique<::spdlog::pattern_formatter>(pattern, timeType);
+}
+
+}} //< NAMESPACE-END: simplelog::backend_spdlog
@@ -0,0 +1,115 @@
+/**
+ * @file simplelog/backend/spdlog/ControlCommands.hpp
+ * Provides the control commands for spdlog loggers (for a ControlServer).
+ *
+ * @code
+ *  #include "simplelog/backend/spdlog/ControlCommands.hpp"
+ *
+ *  simplelog::backend_common::ControlServer server("/tmp/myapp.logctl");
+ *  simplelog::backend_spdlog::addControlCommands(server);
+ *  server.start();
+ * @endcode
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include "simplelog/backend/common/ControlServer.hpp"
+#include "simplelog/backend/spdlog/SetupUtil.hpp"
+#include "simplelog/backend/spdlog/FlightRecorder.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND CONTROL COMMANDS
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_spdlog {
+
+using ControlServer = simplelog::backend_common::ControlServer;
+
+/**
+ * Registers the logging control commands in a ControlServer:
+ *
+ *   - set <module_pattern> <level> [<sink_name>...]   (unknown sink name: ERROR)
+ *   - list   (shows: <logger_name> <level> <counter>)
+ *   - flush
+ *   - dump   (flight recorders of all threads: with the logger of each record)
+ *
+ * @note The dump command uses the loggers (or the DEFAULT_LOGGER for a dropped
+ *       logger) from the server thread: Only thread-safe sinks ("*_mt") are supported.
+ *
+ * The set command is added to the applied LevelConfig (see: addLevelConfig()).
+ * Therefore, it is also used for loggers that are created later.
+ * The server thread assigns the level (an atomic per logger) and publishes
+ * the selected sinks as one SharedSinkSet snapshot (no sinks vector of a
+ * live logger is reassigned).
+ *
+ * @param server  ControlServer to use.
+ * @param sinks   Named sinks (that can be selected with the set command).
+ * @note Selecting sinks lets all loggers use the SharedSinkSet
+ *       (see: useSharedSinkSet()).
+ **/
+inline void addControlCommands(ControlServer& server, NamedSinks sinks = NamedSinks())
+{
+    using Arguments = ControlServer::Arguments;
+    server.addCommand("set", "set <module_pattern> <level> [<sink_name>...]",
+        [sinks](const Arguments& args) -> std::string {
+            Level level;
+            if (args.size() < 2) {
+                return "ERROR: Missing args (expected: <module_pattern> <level>)\n";
+            }
+            if (!parseLevel(args[1], level)) {
+                return "ERROR: Unknown level: " + args[1] + "\n";
+            }
+            const std::vector<std::string> sinkNames(args.begin() + 2, args.end());
+            for (const auto& sinkName : sinkNames) {
+                if (sinks.find(sinkName) == sinks.end()) {
+                    return "ERROR: Unknown sink: " + sinkName + "\n";
+                }
+            }
+            addLevelConfig({{args[0], args[1], sinkNames}}, sinks);
+            return "OK\n";
+        });
+
+    server.addCommand("list", "list",
+        [](const Arguments&) -> std::string {
+            std::vector<std::string> lines;
+            ::spdlog::apply_all([&](LoggerPtr log) {
+                const auto levelName = ::spdlog::level::to_string_view(log->level());
+                lines.push_back((log->name().empty() ? "<default>" : log->name()) + " " +
+                                std::string(levelName.data(), levelName.size()) + " " +
+                                std::to_string(getRecordCount(*log)) + "\n");
+            });
+            std::sort(lines.begin(), lines.end());
+            std::string text;
+            for (const auto& line : lines) {
+                text += line;
+            }
+            return text;
+        });
+
+    server.addCommand("flush", "flush",
+        [](const Arguments&) -> std::string {
+            ::spdlog::apply_all([](LoggerPtr log) { log->flush(); });
+            return "OK\n";
+        });
+
+    server.addCommand("dump", "dump",
+        [](const Arguments&) -> std::string {
+            const auto logger = ::spdlog::default_logger();
+            if (!logger) {
+                return "ERROR: No DEFAULT_LOGGER (maybe: dropped)\n";
+            }
+            try {
+                dumpAllFlightRecorders(logger);
+            } catch (const ::spdlog::spdlog_ex& e) {
+                return std::string("ERROR: ") + e.what() + "\n";
+            }
+            return "OK\n";
+        });
+}
+
+}} //< NAMESPACE-END: simplelog::backend_spdlog
@@ -0,0 +1,89 @@
+/**
+ * @file simplelog/backend/spdlog/CountingLogger.hpp
+ * Provides a spdlog logger that counts its log-records (per logger).
+ *
+ * The counter is incremented when the logger passes a log-record to its
+ * sinks (after the level check). The "list" control command shows it.
+ *
+ * @note spdlog::async_logger is final. Therefore, async loggers (see:
+ *       setupAsync()) are not counted.
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <spdlog/spdlog.h>
+#include <spdlog/logger.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND: COUNTING LOGGER
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_spdlog {
+
+/**
+ * @class RecordCounter
+ * Number of log-records of a logger (relaxed atomic).
+ **/
+class RecordCounter
+{
+private:
+    std::atomic<std::uint64_t> m_counter;
+
+public:
+    RecordCounter() : m_counter(0) {}
+    RecordCounter(const RecordCounter&) : m_counter(0) {}     //< CLONE: Starts with 0.
+    RecordCounter& operator=(const RecordCounter&) = delete;
+    virtual ~RecordCounter() = default;
+
+    std::uint64_t getCounter() const { return m_counter.load(std::memory_order_relaxed); }
+    void resetCounter() { m_counter.store(0, std::memory_order_relaxed); }
+
+protected:
+    void countRecord() { m_counter.fetch_add(1, std::memory_order_relaxed); }
+};
+
+/**
+ * @class CountingLogger
+ * Logger that counts the log-records that it passes to its sinks.
+ **/
+class CountingLogger : public ::spdlog::logger, public RecordCounter
+{
+public:
+    template<typename... Args>
+    explicit CountingLogger(Args&&... args)
+        : ::spdlog::logger(std::forward<Args>(args)...), RecordCounter()
+    {}
+
+    std::shared_ptr<::spdlog::logger> clone(std::string name) override
+    {
+        const CountingLogger& self = *this;     //< USE: Copy constructor.
+        auto cloned = std::make_shared<CountingLogger>(self);
+        cloned->name_ = std::move(name);
+        return cloned;
+    }
+
+protected:
+    void sink_it_(const ::spdlog::details::log_msg& msg) override
+    {
+        countRecord();
+        ::spdlog::logger::sink_it_(msg);
+    }
+};
+
+/**
+ * Returns the number of log-records of this logger.
+ * @return Counter (or 0, if the logger is no CountingLogger).
+ **/
+inline std::uint64_t getRecordCount(const ::spdlog::logger& log)
+{
+    const auto* counter = dynamic_cast<const RecordCounter*>(&log);
+    return counter ? counter->getCounter() : 0;
+}
+
+}} //< NAMESPACE-END: simplelog::backend_spdlog
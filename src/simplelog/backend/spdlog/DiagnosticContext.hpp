@@ -0,0 +1,101 @@
+/**
+ * @file simplelog/backend/spdlog/DiagnosticContext.hpp
+ * Provides a spdlog pattern flag for the thread-local diagnostic context.
+ *
+ * @code
+ *  // -- PATTERN FLAG "%*": Is replaced by "[request=42 tenant=acme] "
+ *  simplelog::backend_spdlog::setPatternWithDiagnosticContext("%n::%l  %*%v");
+ * @endcode
+ *
+ * @note The flag is formatted in the thread that formats the log-record.
+ *       Therefore, it is not usable with spdlog async loggers (the worker
+ *       thread has no context): setPatternWithDiagnosticContext() is rejected
+ *       in async mode and setupAsync() is rejected while the flag is used.
+ * @see simplelog/backend/common/DiagnosticContext.hpp
+ * @see https://github.com/gabime/spdlog/wiki/3.-Custom-formatting#extending-spdlog-with-your-own-flags
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include "simplelog/backend/common/DiagnosticContext.hpp"
+#include <spdlog/spdlog.h>
+#include <spdlog/async.h>
+#include <spdlog/pattern_formatter.h>
+#include <atomic>
+#include <memory>
+#include <string>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND: DIAGNOSTIC CONTEXT
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_spdlog {
+
+using DiagnosticContextScope = simplelog::backend_common::DiagnosticContextScope;
+
+/**
+ * @class DiagnosticContextFlag
+ * Pattern flag formatter: Appends the cached diagnostic context prefix.
+ * The flag is used while any instance exists (in a formatter of a sink or
+ * of the spdlog registry, for new loggers).
+ **/
+class DiagnosticContextFlag : public ::spdlog::custom_flag_formatter
+{
+private:
+    static std::atomic<int>& getInstanceCounter()
+    {
+        static std::atomic<int> theCounter(0);
+        return theCounter;
+    }
+
+public:
+    static constexpr char FLAG = '*';
+
+    DiagnosticContextFlag() { getInstanceCounter().fetch_add(1, std::memory_order_relaxed); }
+    DiagnosticContextFlag(const DiagnosticContextFlag&) : DiagnosticContextFlag() {}
+    DiagnosticContextFlag& operator=(const DiagnosticContextFlag&) = default;
+    ~DiagnosticContextFlag() override { getInstanceCounter().fetch_sub(1, std::memory_order_relaxed); }
+
+    //! Indicates if a formatter uses the flag.
+    static bool isUsed() { return getInstanceCounter().load(std::memory_order_relaxed) > 0; }
+
+    void format(const ::spdlog::details::log_msg&, const std::tm&,
+                ::spdlog::memory_buf_t& dest) override
+    {
+        const auto& prefix = simplelog::backend_common::getDiagnosticContextPrefix();
+        dest.append(prefix.data(), prefix.data() + prefix.size());
+    }
+
+    std::unique_ptr<custom_flag_formatter> clone() const override
+    {
+        return std::make_unique<DiagnosticContextFlag>();
+    }
+};
+
+//! Creates a pattern formatter that supports the flag "%*" (diagnostic context).
+inline std::unique_ptr<::spdlog::pattern_formatter>
+makePatternFormatterWithDiagnosticContext(const std::string& pattern)
+{
+    auto formatter = std::make_unique<::spdlog::pattern_formatter>();
+    formatter->add_flag<DiagnosticContextFlag>(DiagnosticContextFlag::FLAG);
+    formatter->set_pattern(pattern);
+    return formatter;
+}
+
+/**
+ * Assigns the pattern (with flag "%*" for the diagnostic context)
+ * to all existing loggers (and the DEFAULT_LOGGER for new loggers).
+ * @return true, on success. false, in async mode (spdlog thread pool exists).
+ **/
+inline bool setPatternWithDiagnosticContext(const std::string& pattern)
+{
+    if (::spdlog::thread_pool()) {
+        // -- HINT: The worker thread would render an empty context.
+        return false;
+    }
+    ::spdlog::set_formatter(makePatternFormatterWithDiagnosticContext(pattern));
+    return true;
+}
+
+}} //< NAMESPACE-END: simplelog::backend_spdlog
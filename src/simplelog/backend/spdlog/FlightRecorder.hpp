@@ -0,0 +1,139 @@
+/**
+ * @file simplelog/backend/spdlog/FlightRecorder.hpp
+ * Provides the flight recorder (of disabled log-records) for spdlog loggers.
+ *
+ * @see simplelog/backend/common/FlightRecorder.hpp
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include "simplelog/backend/common/FlightRecorder.hpp"
+#include "simplelog/backend/spdlog/ThreadLevelOverride.hpp"  //< USE: detail::LoggerAccess
+#include <spdlog/spdlog.h>
+#include <spdlog/logger.h>
+#include <spdlog/fmt/fmt.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND: FLIGHT RECORDER
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_spdlog {
+
+using FlightRecord = simplelog::backend_common::FlightRecord;
+using simplelog::backend_common::enableFlightRecorder;
+using simplelog::backend_common::isFlightRecorderEnabled;
+
+//! Formats captured log-records (like: logger->log(level, ...)).
+struct FlightRecordFormatter
+{
+    template<typename T>
+    static void format(std::string& text, const T& message)
+    {
+        text = detail::toMessageText(message);
+    }
+
+    template<typename FormatT, typename Arg1, typename... Args>
+    static void format(std::string& text, const FormatT& format,
+                       const Arg1& arg1, const Args&... args)
+    {
+        text = fmt::vformat(std::string_view(format), fmt::make_format_args(arg1, args...));
+    }
+};
+
+namespace detail {
+
+/**
+ * @class FlightRecordDumper
+ * Logs each dumped log-record with the logger of its module
+ * (or with the fallback logger, if that logger is no longer registered).
+ * The log-record passes the logger after its level check (see: LoggerAccess).
+ **/
+class FlightRecordDumper
+{
+private:
+    ::spdlog::logger& m_fallbackLogger;
+    std::vector<std::shared_ptr<::spdlog::logger>> m_usedLoggers;
+
+public:
+    explicit FlightRecordDumper(::spdlog::logger& fallbackLogger)
+        : m_fallbackLogger(fallbackLogger), m_usedLoggers()
+    {}
+
+    void log(const FlightRecord& record, const std::string& text)
+    {
+        const auto level = static_cast<::spdlog::level::level_enum>(record.level);
+        const auto name = record.getName();
+        auto logger = ::spdlog::get(std::string(name));
+        const ::spdlog::details::log_msg message(record.time, ::spdlog::source_loc{},
+            ::spdlog::string_view_t(name.data(), name.size()), level,
+            ::spdlog::string_view_t(text.data(), text.size()));
+        LoggerAccess::logIt(logger ? *logger : m_fallbackLogger, message);
+        if (logger && (logger.get() != &m_fallbackLogger) &&
+            (std::find(m_usedLoggers.begin(), m_usedLoggers.end(), logger) == m_usedLoggers.end())) {
+            m_usedLoggers.push_back(std::move(logger));
+        }
+    }
+
+    void flush()
+    {
+        for (const auto& logger : m_usedLoggers) {
+            logger->flush();
+        }
+        m_fallbackLogger.flush();
+    }
+};
+
+} //< NAMESPACE-END: detail
+
+//! Captures a disabled log-record in the flight recorder of this thread.
+template<typename LoggerT, typename... Args>
+inline void recordInFlightRecorder(const LoggerT& logger, ::spdlog::level::level_enum level,
+                                   const Args&... args)
+{
+    simplelog::backend_common::recordInFlightRecorder<FlightRecordFormatter>(
+        std::string_view(logger->name()), static_cast<int>(level), args...);
+}
+
+/**
+ * Dumps the flight recorder of this thread.
+ * Each log-record is logged with the logger of its module (or this logger).
+ * @note Used before an ERROR (or more severe) log-record is logged.
+ **/
+template<typename LoggerT>
+inline void dumpFlightRecorder(const LoggerT& logger)
+{
+    detail::FlightRecordDumper dumper(*logger);
+    simplelog::backend_common::dumpFlightRecorder(
+        [&dumper](const FlightRecord& record, const std::string& text) {
+            dumper.log(record, text);
+        });
+    dumper.flush();
+}
+
+/**
+ * Dumps the flight recorders of all threads.
+ * Each log-record is logged with the logger of its module (or this logger).
+ * @note The loggers are used from this thread: Only thread-safe sinks ("*_mt") are supported.
+ * @note Nothing is dumped without a logger (nullptr).
+ **/
+template<typename LoggerT>
+inline void dumpAllFlightRecorders(const LoggerT& logger)
+{
+    if (!logger) {
+        return;
+    }
+    detail::FlightRecordDumper dumper(*logger);
+    simplelog::backend_common::dumpAllFlightRecorders(
+        [&dumper](const FlightRecord& record, const std::string& text) {
+            dumper.log(record, text);
+        });
+    dumper.flush();
+}
+
+}} //< NAMESPACE-END: simplelog::backend_spdlog
@@ -0,0 +1,234 @@
+/**
+ * @file simplelog/backend/spdlog/FormatOnceSink.hpp
+ * Provides a sink that formats each log-record once for many outputs.
+ *
+ * Each spdlog sink formats a log-record on its own. Outputs with the same
+ * pattern (console, file, ...) can use one FormatOnceSink instead:
+ * The log-record is formatted once and the formatted bytes are written
+ * to all outputs (writers) of this sink.
+ *
+ * @code
+ *  using namespace simplelog::backend_spdlog;
+ *  auto sink = makeFormatOnceSink("[%Y-%m-%d %T.%e] %n::%l  %v", {
+ *      std::make_shared<CFileWriter>(stderr),
+ *      std::make_shared<FileWriter>("logs/example.log"),
+ *      std::make_shared<SyslogWriter>()
+ *  });
+ *  simplelog::backend_spdlog::assignSink(sink);
+ * @endcode
+ *
+ * @note Outputs with another pattern need another FormatOnceSink.
+ *       Each FormatOnceSink formats in the thread that calls its log():
+ *       The logging thread (or the worker thread of the spdlog thread pool,
+ *       see: setupAsync()). Sinks with different patterns are formatted
+ *       one after another (not in parallel), also in async mode.
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/sink.h>
+#include <spdlog/details/file_helper.h>
+#include <spdlog/pattern_formatter.h>
+#include <syslog.h>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND: FORMAT-ONCE SINK
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_spdlog {
+
+/**
+ * @class FormattedWriter
+ * Output of a FormatOnceSink: Writes an already formatted log-record.
+ * @note Writers are called under the lock of their FormatOnceSink.
+ **/
+class FormattedWriter
+{
+public:
+    virtual ~FormattedWriter() = default;
+    virtual void write(const ::spdlog::details::log_msg& msg,
+                       const ::spdlog::memory_buf_t& formatted) = 0;
+    virtual void flush() = 0;
+};
+
+using FormattedWriterPtr = std::shared_ptr<FormattedWriter>;
+using FormattedWriters = std::vector<FormattedWriterPtr>;
+
+//! Writes formatted log-records to a std::ostream.
+class OstreamWriter : public FormattedWriter
+{
+private:
+    std::ostream& m_stream;
+
+public:
+    explicit OstreamWriter(std::ostream& stream) : m_stream(stream) {}
+
+    void write(const ::spdlog::details::log_msg&, const ::spdlog::memory_buf_t& formatted) override
+    {
+        m_stream.write(formatted.data(), static_cast<std::streamsize>(formatted.size()));
+    }
+    void flush() override { m_stream.flush(); }
+};
+
+//! Writes formatted log-records to a C FILE stream (as: stdout, stderr).
+class CFileWriter : public FormattedWriter
+{
+private:
+    std::FILE* m_file;
+
+public:
+    explicit CFileWriter(std::FILE* file) : m_file(file) {}
+
+    void write(const ::spdlog::details::log_msg&, const ::spdlog::memory_buf_t& formatted) override
+    {
+        std::fwrite(formatted.data(), 1, formatted.size(), m_file);
+    }
+    void flush() override { std::fflush(m_file); }
+};
+
+//! Writes formatted log-records to a file (like: spdlog::sinks::basic_file_sink).
+class FileWriter : public FormattedWriter
+{
+private:
+    ::spdlog::details::file_helper m_fileHelper;
+
+public:
+    explicit FileWriter(const ::spdlog::filename_t& filename, bool truncate = false)
+    {
+        m_fileHelper.open(filename, truncate);
+    }
+
+    const ::spdlog::filename_t& filename() const { return m_fileHelper.filename(); }
+
+    void write(const ::spdlog::details::log_msg&, const ::spdlog::memory_buf_t& formatted) override
+    {
+        m_fileHelper.write(formatted);
+    }
+    void flush() override { m_fileHelper.flush(); }
+};
+
+/**
+ * @class SyslogWriter
+ * Writes formatted log-records with syslog() (like: spdlog::sinks::syslog_sink).
+ * The trailing newline of the pattern is not sent.
+ * @note Use openlog() to set the ident, options and default facility.
+ **/
+class SyslogWriter : public FormattedWriter
+{
+private:
+    int m_facility;     //< ORed with the syslog level (or 0: default facility).
+
+public:
+    explicit SyslogWriter(int facility = 0) : m_facility(facility) {}
+
+    //! Converts a spdlog level into a syslog level.
+    static int toSyslogLevel(::spdlog::level::level_enum level)
+    {
+        static constexpr int levels[::spdlog::level::n_levels] = {
+            LOG_DEBUG,      //< trace
+            LOG_DEBUG,      //< debug
+            LOG_INFO,       //< info
+            LOG_WARNING,    //< warn
+            LOG_ERR,        //< err
+            LOG_CRIT,       //< critical
+            LOG_INFO        //< off
+        };
+        return levels[static_cast<int>(level)];
+    }
+
+    void write(const ::spdlog::details::log_msg& msg, const ::spdlog::memory_buf_t& formatted) override
+    {
+        auto size = formatted.size();
+        if ((size > 0) && (formatted.data()[size - 1] == '\n')) {
+            --size;
+        }
+        // "%.*s": Copies the bytes (no null-terminator needed).
+        ::syslog(toSyslogLevel(msg.level) | m_facility, "%.*s",
+                 static_cast<int>(size), formatted.data());
+    }
+    void flush() override {}
+};
+
+/**
+ * @class FormatOnceSink
+ * Sink that formats each log-record once and writes it to all its writers.
+ **/
+class FormatOnceSink : public ::spdlog::sinks::sink
+{
+private:
+    std::mutex m_mutex;
+    std::unique_ptr<::spdlog::formatter> m_formatter;
+    FormattedWriters m_writers;
+    ::spdlog::memory_buf_t m_formatted;     //< REUSED: For each log-record.
+
+public:
+    explicit FormatOnceSink(FormattedWriters writers = FormattedWriters())
+        : m_formatter(std::make_unique<::spdlog::pattern_formatter>()),
+          m_writers(std::move(writers))
+    {}
+
+    void addWriter(FormattedWriterPtr writer)
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_writers.push_back(std::move(writer));
+    }
+
+    FormattedWriters getWriters()
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_writers;
+    }
+
+    void log(const ::spdlog::details::log_msg& msg) override
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_formatted.clear();
+        m_formatter->format(msg, m_formatted);
+        for (const auto& writer : m_writers) {
+            writer->write(msg, m_formatted);
+        }
+    }
+
+    void flush() override
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& writer : m_writers) {
+            writer->flush();
+        }
+    }
+
+    void set_pattern(const std::string& pattern) override
+    {
+        set_formatter(std::make_unique<::spdlog::pattern_formatter>(pattern));
+    }
+
+    void set_formatter(std::unique_ptr<::spdlog::formatter> formatter) override
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_formatter = std::move(formatter);
+    }
+};
+
+//! Creates a FormatOnceSink with pattern for these writers.
+inline std::shared_ptr<FormatOnceSink>
+makeFormatOnceSink(const std::string& pattern, FormattedWriters writers)
+{
+    auto sink = std::make_shared<FormatOnceSink>(std::move(writers));
+    sink->set_pattern(pattern);
+    return sink;
+}
+
+}} //< NAMESPACE-END: simplelog::backend_spdlog
@@ -12,6 +12,8 @@
 // -- INCLUDES:
 #include <spdlog/spdlog.h>
 #include "simplelog/backend/spdlog/ModuleUtil.hpp"
+#include "simplelog/backend/spdlog/ThreadLevelOverride.hpp"
+#include "simplelog/backend/spdlog/FlightRecorder.hpp"
 
 
 #ifdef SIMPLELOG_BACKEND_LOG
@@ -21,6 +23,18 @@
 #ifndef SIMPLELOG_BACKEND_SPDLOG__USE_SOURCE_LOCATION
 #define SIMPLELOG_BACKEND_SPDLOG__USE_SOURCE_LOCATION 1
 #endif
+#ifndef SIMPLELOG_BACKEND_SPDLOG__USE_LOGGER_HANDLE
+#define SIMPLELOG_BACKEND_SPDLOG__USE_LOGGER_HANDLE 0
+#endif
+#ifndef SIMPLELOG_BACKEND_SPDLOG__USE_LOGGER_CACHE
+#define SIMPLELOG_BACKEND_SPDLOG__USE_LOGGER_CACHE 0
+#endif
+#ifndef SIMPLELOG_BACKEND_SPDLOG__USE_THREAD_LEVEL_OVERRIDE
+#define SIMPLELOG_BACKEND_SPDLOG__USE_THREAD_LEVEL_OVERRIDE 1
+#endif
+#ifndef SIMPLELOG_BACKEND_SPDLOG__USE_FLIGHT_RECORDER
+#define SIMPLELOG_BACKEND_SPDLOG__USE_FLIGHT_RECORDER 1
+#endif
 
 // --------------------------------------------------------------------------
 // LOGGING BACKEND MACROS
@@ -28,9 +42,35 @@
 /**
  * @macro SIMPLELOG_BACKEND_DEFINE_MODULE(var_name, name)
  * Defines a logging module (logger).
+ *
+ * SIMPLELOG_BACKEND_SPDLOG__USE_LOGGER_HANDLE=1:
+ *   Logger is a raw pointer (LoggerHandle) that is pinned by simplelog.
+ *   Avoids the atomic refcount of a shared_ptr on each use.
+ *   REQUIRES: name is a string literal; loggers are not dropped by spdlog.
+ *
+ * SIMPLELOG_BACKEND_SPDLOG__USE_LOGGER_CACHE=1:
+ *   The resolved logger is cached per call-site and thread.
+ *   Avoids spdlog::get() (registry mutex and name hashing) after first use.
+ *   REQUIRES: Loggers are dropped with dropLogger() or dropAllLoggers()
+ *   (not with: spdlog::drop(), spdlog::drop_all(), spdlog::register_logger()).
+ *   OTHERWISE: A call-site keeps using the logger that it resolved before.
  **/
-#define SIMPLELOG_BACKEND_DEFINE_MODULE(var_name, name) \
+#if SIMPLELOG_BACKEND_SPDLOG__USE_LOGGER_HANDLE
+#  define SIMPLELOG_BACKEND_DEFINE_MODULE(var_name, name) \
+    ::simplelog::backend_spdlog::LoggerHandle var_name = \
+        ::simplelog::backend_spdlog::useOrCreateLoggerHandle(SIMPLELOG_BACKEND_MODULE_NAME(name))
+#elif SIMPLELOG_BACKEND_SPDLOG__USE_LOGGER_CACHE
+#  define SIMPLELOG_BACKEND_DEFINE_MODULE(var_name, name) \
+    ::simplelog::backend_spdlog::LoggerPtr var_name = \
+        ::simplelog::backend_spdlog::useOrCreateCachedLogger( \
+            []() -> ::simplelog::backend_spdlog::CachedLogger& { \
+                thread_local ::simplelog::backend_spdlog::CachedLogger theCache; \
+                return theCache; \
+            }(), name)
+#else
+#  define SIMPLELOG_BACKEND_DEFINE_MODULE(var_name, name) \
     auto var_name = ::simplelog::backend_spdlog::useOrCreateLogger(name)
+#endif
 
 /**
  * @macro SIMPLELOG_BACKEND_LOG(logger, level, ...)
@@ -40,8 +80,61 @@
  * CASE 2: SIMPLELOG_BACKEND_LOG(logger, level, format, ...)  -- With placeholders
  **/
 #if SIMPLELOG_BACKEND_SPDLOG__USE_SOURCE_LOCATION
+#  define SIMPLELOG_BACKEND_SPDLOG_SOURCE_LOCATION \
+    ::spdlog::source_loc{__FILE__, __LINE__, SPDLOG_FUNCTION}
+#else
+#  define SIMPLELOG_BACKEND_SPDLOG_SOURCE_LOCATION ::spdlog::source_loc{}
+#endif
+
+/**
+ * SIMPLELOG_BACKEND_SPDLOG__USE_THREAD_LEVEL_OVERRIDE=1:
+ *   A log-record that is disabled by the logger level is still logged
+ *   if a ThreadLevelOverrideScope of the current thread enables it.
+ *   FAST PATH: One thread_local read (only for disabled log-records).
+ *
+ * SIMPLELOG_BACKEND_SPDLOG__USE_FLIGHT_RECORDER=1:
+ *   A disabled log-record is captured by the flight recorder (if enabled).
+ *   An ERROR (or more severe) log-record dumps the captured records first.
+ *   FAST PATH: One relaxed atomic read (only for disabled log-records)
+ *   and one thread_local read (only for ERROR log-records).
+ **/
+#if SIMPLELOG_BACKEND_SPDLOG__USE_THREAD_LEVEL_OVERRIDE
+#  define SIMPLELOG_BACKEND_SPDLOG_IS_LEVEL_ENABLED_FOR_THIS_THREAD(logger, level) \
+    ::simplelog::backend_spdlog::isLevelEnabledForThisThread(logger, level)
+#else
+#  define SIMPLELOG_BACKEND_SPDLOG_IS_LEVEL_ENABLED_FOR_THIS_THREAD(logger, level)  false
+#endif
+
+#if SIMPLELOG_BACKEND_SPDLOG__USE_FLIGHT_RECORDER
+#  define SIMPLELOG_BACKEND_SPDLOG_DUMP_FLIGHT_RECORDER(logger, level) \
+    if ((level >= SIMPLELOG_BACKEND_LEVEL_ERROR) && ::simplelog::backend_common::hasFlightRecords()) { \
+        ::simplelog::backend_spdlog::dumpFlightRecorder(logger); \
+    }
+#  define SIMPLELOG_BACKEND_SPDLOG_RECORD_IN_FLIGHT_RECORDER(logger, level, ...) \
+    if (::simplelog::backend_common::isFlightRecorderEnabled()) { \
+        ::simplelog::backend_spdlog::recordInFlightRecorder(logger, level, __VA_ARGS__); \
+    }
+#else
+#  define SIMPLELOG_BACKEND_SPDLOG_DUMP_FLIGHT_RECORDER(logger, level)
+#  define SIMPLELOG_BACKEND_SPDLOG_RECORD_IN_FLIGHT_RECORDER(logger, level, ...)
+#endif
+
+#if SIMPLELOG_BACKEND_SPDLOG__USE_THREAD_LEVEL_OVERRIDE || SIMPLELOG_BACKEND_SPDLOG__USE_FLIGHT_RECORDER
+#  define SIMPLELOG_BACKEND_LOG(logger, level, ...) \
+    do { \
+        if (logger->should_log(level)) { \
+            SIMPLELOG_BACKEND_SPDLOG_DUMP_FLIGHT_RECORDER(logger, level) \
+            logger->log(SIMPLELOG_BACKEND_SPDLOG_SOURCE_LOCATION, level, __VA_ARGS__); \
+        } else if (SIMPLELOG_BACKEND_SPDLOG_IS_LEVEL_ENABLED_FOR_THIS_THREAD(logger, level)) { \
+            ::simplelog::backend_spdlog::logForThisThread(logger, \
+                SIMPLELOG_BACKEND_SPDLOG_SOURCE_LOCATION, level, __VA_ARGS__); \
+        } else { \
+            SIMPLELOG_BACKEND_SPDLOG_RECORD_IN_FLIGHT_RECORDER(logger, level, __VA_ARGS__) \
+        } \
+    } while (0)
+#elif SIMPLELOG_BACKEND_SPDLOG__USE_SOURCE_LOCATION
 #  define SIMPLELOG_BACKEND_LOG(logger, level, ...) \
-    logger->log(::spdlog::source_loc{__FILE__, __LINE__, SPDLOG_FUNCTION}, level, __VA_ARGS__)
+    logger->log(SIMPLELOG_BACKEND_SPDLOG_SOURCE_LOCATION, level, __VA_ARGS__)
 #else
 #  define SIMPLELOG_BACKEND_LOG(logger, level, ...)  logger->log(level, __VA_ARGS__)
 #endif
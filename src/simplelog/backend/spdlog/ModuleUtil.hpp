@@ -12,11 +12,22 @@
 
 // -- INCLUDES:
 #include "simplelog/detail/DiagMacros.hpp"
+#include "simplelog/backend/common/ModuleName.hpp"
+#include "simplelog/backend/common/LevelConfig.hpp"  //< USE: matchesModulePattern()
+#include "simplelog/backend/spdlog/SharedSinkSet.hpp"
+#include "simplelog/backend/spdlog/CountingLogger.hpp"
 #include <spdlog/spdlog.h>
 #include <spdlog/logger.h>
 #include <spdlog/sinks/stdout_sinks.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 
 // --------------------------------------------------------------------------
@@ -26,6 +37,9 @@ namespace simplelog { namespace backend_spdlog {
 
     using Level = spdlog::level::level_enum;
     using LoggerPtr = std::shared_ptr<::spdlog::logger>;
+    using LoggerHandle = ::spdlog::logger*;     //< Without refcount.
+    using ModuleName = ::simplelog::backend_common::ModuleName;
+    using Sinks = std::vector<::spdlog::sink_ptr>;
 
 
 /**
@@ -52,14 +66,111 @@ inline void inheritSinksFromOther(LoggerPtr& log, const LoggerPtr& other)
         defaultSinks.size());
 }
 
+// --------------------------------------------------------------------------
+// LEVEL CONFIG RULES: Are applied to loggers when they are created.
+// --------------------------------------------------------------------------
+/**
+ * @struct LevelConfigRule
+ * Level (and sinks) of all loggers that match the pattern.
+ **/
+struct LevelConfigRule
+{
+    std::string pattern;    //< Logger pattern (as: "db.*")
+    Level level;
+    Sinks sinks;            //< EMPTY: Keep sinks of logger.
+};
+
+/**
+ * @class LevelConfigRules
+ * Rules for loggers that are created later (as: the applied LevelConfig).
+ * Rules are applied in order (later rules override earlier ones).
+ * @see applyLevelConfig()
+ **/
+class LevelConfigRules
+{
+private:
+    std::vector<LevelConfigRule> m_rules;
+    mutable std::mutex m_mutex;
+
+public:
+    LevelConfigRules() : m_rules(), m_mutex() {}
+    LevelConfigRules(const LevelConfigRules&) = delete;
+    LevelConfigRules& operator=(const LevelConfigRules&) = delete;
+
+    //! Replaces all rules (as: after the config file was reloaded).
+    void setRules(std::vector<LevelConfigRule> rules)
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rules = std::move(rules);
+    }
+
+    //! Adds rules (after the existing rules).
+    void addRules(const std::vector<LevelConfigRule>& rules)
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rules.insert(m_rules.end(), rules.begin(), rules.end());
+    }
+
+    void clear()
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rules.clear();
+    }
+
+    /**
+     * Applies the matching rules to a new logger (before it is used).
+     * A logger that uses the SharedSinkSet gets its sinks as SinkRoutes entry.
+     **/
+    void applyTo(const LoggerPtr& log) const
+    {
+        using simplelog::backend_common::matchesModulePattern;
+        const LevelConfigRule* levelRule = nullptr;
+        const LevelConfigRule* sinksRule = nullptr;
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& rule : m_rules) {
+            if (matchesModulePattern(rule.pattern, log->name())) {
+                levelRule = &rule;
+                sinksRule = rule.sinks.empty() ? sinksRule : &rule;
+            }
+        }
+        if (levelRule) {
+            log->set_level(levelRule->level);
+        }
+        if (!sinksRule) {
+            return;
+        }
+        const auto& sinkSet = getSharedSinkSet();
+        const auto& logSinks = log->sinks();
+        if ((logSinks.size() == 1) && (logSinks.front() == sinkSet)) {
+            sinkSet->updateRoutes([&](SinkRoutes& routes) {
+                routes.loggerSinks[log->name()] = sinksRule->sinks;
+            });
+        } else {
+            log->sinks() = sinksRule->sinks;
+        }
+    }
+};
+
+//! Provides the LevelConfigRules that are applied to new loggers.
+inline LevelConfigRules& getLevelConfigRules()
+{
+    static LevelConfigRules theRules;
+    return theRules;
+}
+
 /**
  * Creates an unregistered logger without sink.
+ * The logger counts its log-records (see: getRecordCount()).
  * @param name  Name of the logger/category/module (as string).
  * @return Pointer to newly created logger (as shared_ptr).
  **/
 inline auto makeLogger(std::string name) -> LoggerPtr
 {
-    return std::make_shared<::spdlog::logger>(name);
+    return std::make_shared<CountingLogger>(name);
 }
 
 /**
@@ -80,6 +191,7 @@ inline LoggerPtr createAndRegisterLogger(const std::string& name, bool inheritSi
         // -- INHERIT SINKS FROM: DEFAULT_LOGGER (used as prototype)
         inheritSinksFromOther(newLogger, defaultLogger);
     }
+    getLevelConfigRules().applyTo(newLogger);
     // ALREADY-DONE: spdlog::register_logger(logPtr);
     // POSTCONDITION(spdlog::get(name) == logPtr, "logger is registered");
     assert(spdlog::get(name) == newLogger);
@@ -103,6 +215,7 @@ inline auto useOrCreateLogger(const std::string& name) -> LoggerPtr
         if (prototype) {
             // -- STRATEGY 1: Clone DEFAULT_LOGGER to inherit configuration.
             logPtr = prototype->clone(name);
+            getLevelConfigRules().applyTo(logPtr);
             spdlog::register_logger(logPtr);
             SIMPLELOG_DIAG_TRACE(
                 "useOrCreateLogger: Create log={0}  with config from DEFAULT_LOGGER (cloned)",
@@ -120,4 +233,170 @@ inline auto useOrCreateLogger(const std::string& name) -> LoggerPtr
     return logPtr;
 }
 
+/**
+ * @class LoggerHandleRegistry
+ * Pins loggers so that raw logger pointers (LoggerHandle) stay valid.
+ * Loggers are looked up by ModuleName (one hash probe, no std::string).
+ *
+ * @note A pinned logger is not destroyed if it is dropped from spdlog.
+ *       Use dropAllLoggers() instead of spdlog::drop_all() to unpin them.
+ * @note An unpinned logger is retired (kept alive until the program ends).
+ *       Therefore, a LoggerHandle (as: in a static variable) never dangles.
+ **/
+class LoggerHandleRegistry
+{
+private:
+    //! KEY: ModuleName views the logger name (owned by the pinned logger).
+    using LoggerMap = std::unordered_map<ModuleName, LoggerPtr, ModuleName::Hasher>;
+    LoggerMap m_loggers;
+    std::vector<LoggerPtr> m_retiredLoggers;    //< Used by old LoggerHandle(s).
+    mutable std::mutex m_mutex;
+
+public:
+    LoggerHandleRegistry() : m_loggers(), m_retiredLoggers(), m_mutex() {}
+    LoggerHandleRegistry(const LoggerHandleRegistry&) = delete;
+    LoggerHandleRegistry& operator=(const LoggerHandleRegistry&) = delete;
+
+    std::size_t size() const
+    {
+        // -- CRITICAL-SECTION
+        const std::lock_guard<std::mutex> guard(m_mutex);
+        return m_loggers.size();
+    }
+
+    LoggerHandle useOrCreateLogger(const ModuleName& name)
+    {
+        // -- CRITICAL-SECTION
+        const std::lock_guard<std::mutex> guard(m_mutex);
+        auto iter = m_loggers.find(name);
+        if (iter != m_loggers.end()) {
+            return iter->second.get();
+        }
+        auto logPtr = ::simplelog::backend_spdlog::useOrCreateLogger(name.toString());
+        const auto key = ModuleName(logPtr->name(), name.getHash());
+        m_loggers.emplace(key, logPtr);
+        return logPtr.get();
+    }
+
+    /**
+     * Pins the logger instead of the pinned logger with the same name
+     * (as: its async replacement). The replaced logger is retired.
+     * @note An old LoggerHandle still uses the replaced logger.
+     **/
+    void replaceLogger(const LoggerPtr& log)
+    {
+        // -- CRITICAL-SECTION
+        const std::lock_guard<std::mutex> guard(m_mutex);
+        auto iter = m_loggers.find(ModuleName(log->name()));
+        if (iter == m_loggers.end()) {
+            return;     //< NOT PINNED: Is pinned on first use.
+        }
+        const auto key = ModuleName(log->name(), iter->first.getHash());
+        m_retiredLoggers.push_back(std::move(iter->second));
+        m_loggers.erase(iter);
+        m_loggers.emplace(key, log);
+    }
+
+    /**
+     * Unpins all loggers (new lookups use the loggers of spdlog again).
+     * The unpinned loggers are retired: Any LoggerHandle stays valid
+     * (but uses a logger that is no longer registered in spdlog).
+     **/
+    void clear()
+    {
+        // -- CRITICAL-SECTION
+        const std::lock_guard<std::mutex> guard(m_mutex);
+        for (auto& item : m_loggers) {
+            m_retiredLoggers.push_back(std::move(item.second));
+        }
+        m_loggers.clear();
+    }
+};
+
+inline LoggerHandleRegistry& getLoggerHandleRegistry()
+{
+    static LoggerHandleRegistry theRegistry;
+    return theRegistry;
+}
+
+/**
+ * Use existing logger or create a new one with this name.
+ * Returns a raw logger pointer that stays valid (until dropAllLoggers()).
+ * @note No atomic refcount operations on the shared logger.
+ *
+ * @param name  Logger (module) name.
+ * @return Pointer to logger object (as LoggerHandle).
+ **/
+inline auto useOrCreateLoggerHandle(const ModuleName& name) -> LoggerHandle
+{
+    return getLoggerHandleRegistry().useOrCreateLogger(name);
+}
+
+// --------------------------------------------------------------------------
+// LOGGER CACHE: Per call-site and per thread (used by SIMPLELOG_DEFINE_MODULE)
+// --------------------------------------------------------------------------
+/**
+ * @struct CachedLogger
+ * Cache entry for a resolved logger (one per call-site and thread).
+ * The entry is valid if its generation is the current cache generation.
+ **/
+struct CachedLogger
+{
+    std::uint64_t generation = 0;   //< ZERO: Not resolved yet.
+    LoggerPtr logger;
+};
+
+namespace detail {
+inline std::atomic<std::uint64_t> loggerCacheGeneration(1);
+} //< NAMESPACE-END: detail
+
+//! Invalidates all CachedLogger entries (after loggers were dropped, ...).
+inline void invalidateLoggerCaches()
+{
+    detail::loggerCacheGeneration.fetch_add(1, std::memory_order_acq_rel);
+}
+
+/**
+ * Use the cached logger or resolve it (with useOrCreateLogger()).
+ * FAST PATH: Lock-free (no spdlog registry mutex, no hashing of the name).
+ *
+ * @param cache  Cache entry of this call-site (and thread).
+ * @param name   Logger (module) name.
+ * @return Pointer to logger object.
+ **/
+inline const LoggerPtr& useOrCreateCachedLogger(CachedLogger& cache, std::string_view name)
+{
+    const auto generation = detail::loggerCacheGeneration.load(std::memory_order_acquire);
+    if ((cache.generation != generation) || (cache.logger->name() != name)) {
+        // -- SLOW PATH: First use, loggers were dropped or other name is used.
+        cache.logger = useOrCreateLogger(std::string(name));
+        cache.generation = generation;
+    }
+    return cache.logger;
+}
+
+/**
+ * Drops a logger from spdlog and invalidates all logger caches.
+ * @note Use this function instead of spdlog::drop().
+ * @see spdlog::drop()
+ **/
+inline void dropLogger(const std::string& name)
+{
+    ::spdlog::drop(name);
+    invalidateLoggerCaches();
+}
+
+/**
+ * Drops all loggers from spdlog and unpins all LoggerHandle(s).
+ * Invalidates all logger caches.
+ * @note A LoggerHandle of a dropped logger stays valid (logger is retired).
+ * @see spdlog::drop_all()
+ **/
+inline void dropAllLoggers()
+{
+    getLoggerHandleRegistry().clear();
+    ::spdlog::drop_all();
+    invalidateLoggerCaches();
+}
+
 }} //< NAMESPACE-END: simplelog::backend::spdlog
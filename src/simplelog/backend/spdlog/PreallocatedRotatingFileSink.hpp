@@ -0,0 +1,436 @@
+/**
+ * @file simplelog/backend/spdlog/PreallocatedRotatingFileSink.hpp
+ * Provides a rotating file sink with preallocated segment files.
+ *
+ * Differences to spdlog::sinks::rotating_file_sink:
+ *
+ *   - Each segment file is preallocated with fallocate(FALLOC_FL_KEEP_SIZE)
+ *     (instead of growing the file one block at a time).
+ *   - Log-records are written with one write() per (large) buffer.
+ *   - A completed (or closed) segment is trimmed to its written size
+ *     (releases the preallocated tail), synced and dropped from the page cache
+ *     with posix_fadvise(POSIX_FADV_DONTNEED).
+ *   - Segment files are numbered ("logs/app.1.log", "logs/app.2.log", ...).
+ *     Rotation is an O(1) switch to the next (already prepared) segment.
+ *     A background thread prepares the next segment, retires the completed
+ *     segment and removes the oldest segment (no rename chain).
+ *   - On startup, the existing segment files are kept: Numbering continues
+ *     after the highest index. The existing segments count as kept files
+ *     (the oldest ones are removed if there are too many).
+ *
+ * @note FLUSH: Log-records stay in the write buffer until it is full or flushed.
+ *       Flush periodically (and on errors), otherwise a crash loses them
+ *       (and "tail -f" shows nothing).
+ *
+ * @code
+ *  using simplelog::backend_spdlog::PreallocatedRotatingFileSinkMT;
+ *  auto sink = std::make_shared<PreallocatedRotatingFileSinkMT>(
+ *      "logs/app.log", 64 * 1024 * 1024, 5);   //< 5 segments of 64 MiB.
+ *  simplelog::backend_spdlog::assignSink(sink);
+ *  spdlog::flush_every(std::chrono::seconds(1));
+ *  spdlog::flush_on(spdlog::level::err);
+ * @endcode
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/details/file_helper.h>
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/details/os.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cctype>
+#include <cerrno>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND: PREALLOCATED ROTATING FILE SINK
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_spdlog {
+
+namespace detail {
+
+struct SegmentFile
+{
+    int fd;
+    std::size_t index;
+    ::spdlog::filename_t filename;
+};
+
+/**
+ * Finds the indexes of the existing segment files of a base filename
+ * (as: "logs/app.log" => "logs/app.1.log", "logs/app.7.log" => {1, 7}).
+ * @return Sorted indexes (or empty, if the directory does not exist).
+ **/
+inline std::vector<std::size_t> findSegmentIndexes(const ::spdlog::filename_t& baseFilename)
+{
+    ::spdlog::filename_t basename;
+    ::spdlog::filename_t extension;
+    std::tie(basename, extension) = ::spdlog::details::file_helper::split_by_extension(baseFilename);
+    const auto directory = ::spdlog::details::os::dir_name(basename);
+    const auto prefix = basename.substr(directory.empty() ? 0 : directory.size() + 1) + ".";
+
+    std::vector<std::size_t> indexes;
+    DIR* dir = ::opendir(directory.empty() ? "." : directory.c_str());
+    if (!dir) {
+        return indexes;
+    }
+    while (const dirent* entry = ::readdir(dir)) {
+        const std::string name(entry->d_name);
+        if ((name.size() <= prefix.size() + extension.size()) ||
+            (name.compare(0, prefix.size(), prefix) != 0) ||
+            (name.compare(name.size() - extension.size(), extension.size(), extension) != 0)) {
+            continue;
+        }
+        const auto digits = name.substr(prefix.size(), name.size() - prefix.size() - extension.size());
+        const bool isIndex = (digits.size() <= 18) && (digits[0] != '0') &&
+            std::all_of(digits.begin(), digits.end(), [](char c) {
+                return std::isdigit(static_cast<unsigned char>(c)) != 0;
+            });
+        if (isIndex) {
+            indexes.push_back(static_cast<std::size_t>(std::stoull(digits)));
+        }
+    }
+    ::closedir(dir);
+    std::sort(indexes.begin(), indexes.end());
+    return indexes;
+}
+
+/**
+ * @class SegmentWorker
+ * Background thread that prepares and retires the segment files.
+ *
+ *   - PREPARE: Opens and preallocates the next segment file.
+ *   - RETIRE:  Trims, syncs, drops from page cache and closes a completed segment.
+ *              Removes the oldest segment file (that is no longer kept).
+ **/
+class SegmentWorker
+{
+private:
+    struct RetireTask
+    {
+        int fd;
+        std::size_t size;
+        ::spdlog::filename_t removeFilename;
+    };
+
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::size_t m_preallocateSize;
+    bool m_prepareRequested;
+    ::spdlog::filename_t m_prepareFilename;
+    std::size_t m_prepareIndex;
+    bool m_prepared;
+    SegmentFile m_preparedSegment;
+    std::deque<RetireTask> m_retireTasks;
+    bool m_stopped;
+    std::thread m_thread;
+
+public:
+    explicit SegmentWorker(std::size_t preallocateSize)
+        : m_preallocateSize(preallocateSize),
+          m_prepareRequested(false),
+          m_prepareFilename(),
+          m_prepareIndex(0),
+          m_prepared(false),
+          m_preparedSegment{-1, 0, ::spdlog::filename_t()},
+          m_retireTasks(),
+          m_stopped(false),
+          m_thread()
+    {
+        m_thread = std::thread([this]() { run(); });
+    }
+
+    ~SegmentWorker()
+    {
+        {
+            // -- CRITICAL-SECTION
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopped = true;
+        }
+        m_changed.notify_all();
+        m_thread.join();
+        if (m_prepared) {
+            ::close(m_preparedSegment.fd);
+            ::unlink(m_preparedSegment.filename.c_str());
+        }
+    }
+
+    //! Opens a segment file and preallocates its disk space.
+    static SegmentFile openSegment(const ::spdlog::filename_t& filename, std::size_t index,
+                                   std::size_t preallocateSize)
+    {
+        ::spdlog::details::os::create_dir(::spdlog::details::os::dir_name(filename));
+        const int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            ::spdlog::throw_spdlog_ex("Failed opening file " + filename + " for writing", errno);
+        }
+        // -- HINT: KEEP_SIZE: File size shows only written data (no zero tail).
+        // Unsupported by the filesystem: File grows as usual.
+        if (::fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(preallocateSize)) != 0) {
+            // -- IGNORE
+        }
+        return SegmentFile{fd, index, filename};
+    }
+
+    //! Requests that the next segment file is prepared (in the background).
+    void prepare(const ::spdlog::filename_t& filename, std::size_t index)
+    {
+        {
+            // -- CRITICAL-SECTION
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_prepareRequested = true;
+            m_prepareFilename = filename;
+            m_prepareIndex = index;
+        }
+        m_changed.notify_all();
+    }
+
+    /**
+     * Takes the prepared segment file (waits until it is prepared).
+     * @note Opens the segment file directly if the worker failed.
+     **/
+    SegmentFile takePrepared(const ::spdlog::filename_t& filename, std::size_t index)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this]() { return !m_prepareRequested; });
+        if (m_prepared && (m_preparedSegment.index == index)) {
+            m_prepared = false;
+            return m_preparedSegment;
+        }
+        lock.unlock();
+        return openSegment(filename, index, m_preallocateSize);
+    }
+
+    //! Retires a completed segment file (in the background).
+    void retire(int fd, std::size_t size, const ::spdlog::filename_t& removeFilename)
+    {
+        {
+            // -- CRITICAL-SECTION
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_retireTasks.push_back(RetireTask{fd, size, removeFilename});
+        }
+        m_changed.notify_all();
+    }
+
+    /**
+     * Retires a segment file.
+     * @param size  Written size (the preallocated tail after it is released).
+     **/
+    static void retireNow(int fd, std::size_t size, const ::spdlog::filename_t& removeFilename)
+    {
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            // -- IGNORE: Preallocated tail stays allocated.
+        }
+        // -- HINT: Dirty pages are not dropped. Therefore, sync first.
+        ::fdatasync(fd);
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+        if (!removeFilename.empty()) {
+            ::unlink(removeFilename.c_str());
+        }
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_changed.wait(lock, [this]() {
+                return m_stopped || m_prepareRequested || !m_retireTasks.empty();
+            });
+            if (m_prepareRequested) {
+                const auto filename = m_prepareFilename;
+                const auto index = m_prepareIndex;
+                lock.unlock();
+                SegmentFile segment{-1, index, filename};
+                try {
+                    segment = openSegment(filename, index, m_preallocateSize);
+                } catch (const ::spdlog::spdlog_ex&) {
+                    // -- IGNORE: takePrepared() retries (and reports the error).
+                }
+                lock.lock();
+                m_prepared = (segment.fd >= 0);
+                m_preparedSegment = segment;
+                m_prepareRequested = false;
+                m_changed.notify_all();
+            }
+            while (!m_retireTasks.empty()) {
+                const auto task = m_retireTasks.front();
+                m_retireTasks.pop_front();
+                lock.unlock();
+                retireNow(task.fd, task.size, task.removeFilename);
+                lock.lock();
+            }
+            if (m_stopped) {
+                break;
+            }
+        }
+    }
+};
+
+} //< NAMESPACE-END: detail
+
+/**
+ * @class PreallocatedRotatingFileSink
+ * Rotating file sink with preallocated segment files.
+ * @see detail::SegmentWorker
+ **/
+template<typename Mutex>
+class PreallocatedRotatingFileSink final : public ::spdlog::sinks::base_sink<Mutex>
+{
+public:
+    static constexpr std::size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+private:
+    ::spdlog::filename_t m_baseFilename;
+    std::size_t m_maxSize;
+    std::size_t m_maxFiles;
+    std::vector<char> m_buffer;
+    std::deque<std::size_t> m_segmentIndexes;   //< Kept segment files (oldest first, incl. current).
+    detail::SegmentFile m_segment;
+    std::size_t m_segmentSize;
+    detail::SegmentWorker m_worker;
+
+public:
+    /**
+     * Creates the sink and opens a new segment file
+     * (after the existing segment files; the oldest ones are removed).
+     * @param baseFilename  Base filename (as: "logs/app.log" => "logs/app.1.log", ...)
+     * @param maxSize       Max size of one segment file (is preallocated).
+     * @param maxFiles      Number of segment files to keep (incl. current one).
+     * @param bufferSize    Size of the write buffer.
+     **/
+    PreallocatedRotatingFileSink(::spdlog::filename_t baseFilename,
+                                 std::size_t maxSize, std::size_t maxFiles,
+                                 std::size_t bufferSize = DEFAULT_BUFFER_SIZE)
+        : m_baseFilename(std::move(baseFilename)),
+          m_maxSize(maxSize),
+          m_maxFiles(std::max<std::size_t>(maxFiles, 1)),
+          m_buffer(),
+          m_segmentIndexes(),
+          m_segment(),
+          m_segmentSize(0),
+          m_worker(maxSize)
+    {
+        if (maxSize == 0) {
+            ::spdlog::throw_spdlog_ex("PreallocatedRotatingFileSink: maxSize must be greater than 0");
+        }
+        m_buffer.reserve(std::min(bufferSize, maxSize));
+        // -- RESTART: Keep the existing segment files (never truncate them).
+        const auto indexes = detail::findSegmentIndexes(m_baseFilename);
+        const auto firstIndex = indexes.empty() ? 1 : (indexes.back() + 1);
+        m_segmentIndexes.assign(indexes.begin(), indexes.end());
+        m_segment = detail::SegmentWorker::openSegment(calcFilename(firstIndex), firstIndex, m_maxSize);
+        m_segmentIndexes.push_back(firstIndex);
+        while (m_segmentIndexes.size() > m_maxFiles) {
+            ::unlink(calcFilename(m_segmentIndexes.front()).c_str());
+            m_segmentIndexes.pop_front();
+        }
+        m_worker.prepare(calcFilename(firstIndex + 1), firstIndex + 1);
+    }
+
+    ~PreallocatedRotatingFileSink() override
+    {
+        try {
+            writeBuffer();
+        } catch (const ::spdlog::spdlog_ex&) {
+            // -- IGNORE: In destructor.
+        }
+        detail::SegmentWorker::retireNow(m_segment.fd, m_segmentSize, ::spdlog::filename_t());
+    }
+
+    //! Filename of the current segment file.
+    ::spdlog::filename_t filename()
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<Mutex> lock(::spdlog::sinks::base_sink<Mutex>::mutex_);
+        return m_segment.filename;
+    }
+
+    //! Filename of a segment file (as: "logs/app.3.log").
+    ::spdlog::filename_t calcFilename(std::size_t index) const
+    {
+        ::spdlog::filename_t basename;
+        ::spdlog::filename_t extension;
+        std::tie(basename, extension) =
+            ::spdlog::details::file_helper::split_by_extension(m_baseFilename);
+        return basename + "." + std::to_string(index) + extension;
+    }
+
+protected:
+    void sink_it_(const ::spdlog::details::log_msg& msg) override
+    {
+        ::spdlog::memory_buf_t formatted;
+        ::spdlog::sinks::base_sink<Mutex>::formatter_->format(msg, formatted);
+        const auto usedSize = m_segmentSize + m_buffer.size();
+        if ((usedSize > 0) && (usedSize + formatted.size() > m_maxSize)) {
+            rotate();
+        }
+        if (m_buffer.size() + formatted.size() > m_buffer.capacity()) {
+            writeBuffer();
+        }
+        m_buffer.insert(m_buffer.end(), formatted.begin(), formatted.end());
+    }
+
+    void flush_() override
+    {
+        writeBuffer();
+    }
+
+private:
+    void writeBuffer()
+    {
+        const char* data = m_buffer.data();
+        std::size_t remaining = m_buffer.size();
+        while (remaining > 0) {
+            const auto written = ::write(m_segment.fd, data, remaining);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ::spdlog::throw_spdlog_ex("Failed writing to file " + m_segment.filename, errno);
+            }
+            data += written;
+            remaining -= static_cast<std::size_t>(written);
+        }
+        m_segmentSize += m_buffer.size();
+        m_buffer.clear();
+    }
+
+    //! Switches to the next (prepared) segment file: O(1) on this thread.
+    void rotate()
+    {
+        writeBuffer();
+        const auto nextIndex = m_segment.index + 1;
+        const auto completedFd = m_segment.fd;
+        const auto completedSize = m_segmentSize;
+        m_segment = m_worker.takePrepared(calcFilename(nextIndex), nextIndex);
+        m_segmentSize = 0;
+        m_segmentIndexes.push_back(nextIndex);
+        ::spdlog::filename_t removeFilename;
+        if (m_segmentIndexes.size() > m_maxFiles) {
+            removeFilename = calcFilename(m_segmentIndexes.front());
+            m_segmentIndexes.pop_front();
+        }
+        m_worker.retire(completedFd, completedSize, removeFilename);
+        m_worker.prepare(calcFilename(nextIndex + 1), nextIndex + 1);
+    }
+};
+
+using PreallocatedRotatingFileSinkMT = PreallocatedRotatingFileSink<std::mutex>;
+using PreallocatedRotatingFileSinkST = PreallocatedRotatingFileSink<::spdlog::details::null_mutex>;
+
+}} //< NAMESPACE-END: simplelog::backend_spdlog
@@ -9,8 +9,20 @@
 
 // -- INCLUDES:
 #include "simplelog/detail/DiagMacros.hpp"
+#include "simplelog/backend/spdlog/ModuleUtil.hpp"  //< USE: makeLogger()
+#include "simplelog/backend/spdlog/SharedSinkSet.hpp"
+#include "simplelog/backend/spdlog/CachedPrefixFormatter.hpp"
+#include "simplelog/backend/spdlog/DiagnosticContext.hpp"
+#include "simplelog/backend/common/LevelConfig.hpp"
 #include <spdlog/spdlog.h>
 #include <spdlog/logger.h>
+#include <spdlog/async.h>
+#include <spdlog/async_logger.h>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 
@@ -30,10 +42,239 @@ namespace simplelog { namespace backend_spdlog {
 
 //! Lambda predicate function that matches any logger.
 // DISABLED: constexpr
-const auto matchesEachLogger = [](LoggerPtr) {
+const auto matchesEachLogger = [](const LoggerPtr&) {
     return true; 
 };
 
+//! Indicates if the logger uses the SharedSinkSet (as its only sink).
+inline bool usesSharedSinkSet(const LoggerPtr& log)
+{
+    const auto& sinks = log->sinks();
+    return (sinks.size() == 1) && (sinks.front() == getSharedSinkSet());
+}
+
+/**
+ * Lets all loggers use the SharedSinkSet (as their only sink).
+ * The current sinks of each logger are kept (as its SinkRoutes entry).
+ * New loggers inherit the SharedSinkSet from the DEFAULT_LOGGER.
+ *
+ * Afterwards, a ConfigTransaction changes the sinks of all loggers
+ * by publishing one SinkRoutes snapshot (no sinks of a logger are assigned).
+ *
+ * @note Call this function during the setup of the logging subsystem:
+ *       It assigns the sinks of existing loggers (not thread-safe).
+ **/
+inline void useSharedSinkSet()
+{
+    const auto& sinkSet = getSharedSinkSet();
+    if (::spdlog::default_logger() == nullptr) {
+        SIMPLELOG_DIAG_TRACE0("useSharedSinkSet: Create DEFAULT_LOGGER");
+        ::spdlog::set_default_logger(makeLogger(""));
+    }
+
+    // -- HINT: Loggers can not be changed in spdlog::apply_all() (DEADLOCK).
+    std::vector<LoggerPtr> loggers;
+    ::spdlog::apply_all([&](const LoggerPtr& log) {
+        if (!usesSharedSinkSet(log)) {
+            loggers.push_back(log);
+        }
+    });
+    if (loggers.empty()) {
+        return;
+    }
+
+    const auto defaultLogger = ::spdlog::default_logger();
+    SinkRoutes routes = *sinkSet->getRoutes();
+    if (!usesSharedSinkSet(defaultLogger)) {
+        routes.sinks = defaultLogger->sinks();
+    }
+    for (const auto& log : loggers) {
+        if (log->sinks() != routes.sinks) {
+            routes.loggerSinks[log->name()] = log->sinks();
+        }
+    }
+    sinkSet->setRoutes(std::move(routes));
+    for (const auto& log : loggers) {
+        SIMPLELOG_DIAG_TRACE("useSharedSinkSet: log={0} uses SharedSinkSet",
+            (log->name().empty() ? std::string("DEFAULT_LOGGER") : log->name()));
+        log->sinks() = Sinks{ sinkSet };
+    }
+}
+
+/**
+ * @class ConfigTransaction
+ * Stages many configuration changes (levels, sinks) for many loggers
+ * and publishes them with commit() in one logging-registry pass.
+ *
+ * The final config of each logger is computed first (by applying all staged
+ * changes in order). Then it is published:
+ *
+ *   - SINKS: As one immutable SinkRoutes snapshot of the SharedSinkSet
+ *     (one atomic swap for all loggers: A log-record uses either the old or
+ *     the new sinks). The sinks vector of a logger is never assigned.
+ *   - LEVELS: Each logger changes from its old to its new level once
+ *     (without intermediate levels of a sequence of setLevelToAny(),
+ *     setMinLevel(), ... calls).
+ *
+ * @code
+ *  using simplelog::backend_spdlog::ConfigTransaction;
+ *  simplelog::backend_spdlog::useSharedSinkSet();  //< DURING SETUP.
+ *  ...
+ *  ConfigTransaction()
+ *      .assignSinks({consoleSink, fileSink})
+ *      .setLevelToAny(SIMPLELOG_BACKEND_LEVEL_DEBUG, hasNameStartingWithDb)
+ *      .setMinLevel(SIMPLELOG_BACKEND_LEVEL_INFO)
+ *      .commit();
+ * @endcode
+ * @pre  Staged sinks are only used for loggers that use the SharedSinkSet
+ *       (see: useSharedSinkSet()). Other loggers keep their sinks.
+ * @note spdlog stores the level per logger (as atomic, checked before any sink).
+ *       Therefore, levels are assigned one logger after another
+ *       (after the sinks snapshot was published).
+ **/
+class ConfigTransaction
+{
+public:
+    struct LoggerConfig
+    {
+        Level level;
+        const Sinks* sinks;
+    };
+    using ConfigStep = std::function<void(const LoggerPtr&, LoggerConfig&)>;
+
+private:
+    std::vector<ConfigStep> m_steps;
+    std::shared_ptr<const Sinks> m_defaultSinks;    //< Staged by assignSinks().
+    bool m_hasSinks;
+
+public:
+    ConfigTransaction() : m_steps(), m_defaultSinks(), m_hasSinks(false) {}
+
+    bool empty() const { return m_steps.empty(); }
+    std::size_t size() const { return m_steps.size(); }
+
+    //! Stages: Assign log-level to any logger that matches the predicate.
+    template<typename PredicateT>
+    ConfigTransaction& setLevelToAny(Level level, PredicateT predicate)
+    {
+        m_steps.emplace_back([=](const LoggerPtr& log, LoggerConfig& config) {
+            if (predicate(log)) {
+                config.level = level;
+            }
+        });
+        return *this;
+    }
+
+    //! Stages: Ensure that all loggers use at least this log-level.
+    ConfigTransaction& setMinLevel(Level minLevel)
+    {
+        m_steps.emplace_back([=](const LoggerPtr&, LoggerConfig& config) {
+            if (config.level < minLevel) {
+                config.level = minLevel;
+            }
+        });
+        return *this;
+    }
+
+    //! Stages: Assign sinks to any logger that matches the predicate.
+    template<typename PredicateT>
+    ConfigTransaction& assignSinksToAny(Sinks sinks, PredicateT predicate)
+    {
+        // -- HINT: Sinks are owned by the shared_ptr (captured by the step).
+        auto sinksPtr = std::make_shared<const Sinks>(std::move(sinks));
+        m_hasSinks = true;
+        m_steps.emplace_back([=](const LoggerPtr& log, LoggerConfig& config) {
+            if (predicate(log)) {
+                config.sinks = sinksPtr.get();
+            }
+        });
+        return *this;
+    }
+
+    template<typename PredicateT>
+    ConfigTransaction& assignSinkToAny(SinkPtr sink, PredicateT predicate)
+    {
+        return assignSinksToAny(Sinks{ std::move(sink) }, std::move(predicate));
+    }
+
+    //! Stages: Assign sinks to all loggers (inherited by new loggers).
+    ConfigTransaction& assignSinks(Sinks sinks)
+    {
+        m_defaultSinks = std::make_shared<const Sinks>(sinks);
+        return assignSinksToAny(std::move(sinks), matchesEachLogger);
+    }
+
+    ConfigTransaction& assignSink(SinkPtr sink)
+    {
+        return assignSinks(Sinks{ std::move(sink) });
+    }
+
+private:
+    //! Applies the staged steps to all loggers (returns the new SinkRoutes).
+    SinkRoutes computeConfig(const SinkRoutes& routes,
+                             std::vector<std::pair<LoggerPtr, Level>>& newLevels) const
+    {
+        SinkRoutes newRoutes;
+        newRoutes.sinks = m_defaultSinks ? *m_defaultSinks : routes.sinks;
+        if (!m_defaultSinks) {
+            newRoutes.loggerSinks = routes.loggerSinks;
+        }
+        ::spdlog::apply_all([&](const LoggerPtr& log) {
+            const Sinks& currentSinks = routes.findSinks(log->name());
+            LoggerConfig config{ log->level(), &currentSinks };
+            for (const auto& step : m_steps) {
+                step(log, config);
+            }
+            if (!usesSharedSinkSet(log)) {
+                SIMPLELOG_DIAG_TRACE("ConfigTransaction: Keep sinks of log={0} "
+                    "(not using SharedSinkSet)", log->name());
+            } else if (*config.sinks != newRoutes.sinks) {
+                newRoutes.loggerSinks[log->name()] = *config.sinks;
+            } else {
+                newRoutes.loggerSinks.erase(log->name());
+            }
+            if (config.level != log->level()) {
+                newLevels.emplace_back(log, config.level);
+            }
+        });
+        return newRoutes;
+    }
+
+public:
+    /**
+     * Publishes all staged changes (computed in one pass over all loggers).
+     * @note Uses logging-registry synchronized operation mechanism
+     **/
+    void commit() const
+    {
+        const auto& sinkSet = getSharedSinkSet();
+        if (m_defaultSinks && (::spdlog::default_logger() == nullptr)) {
+            // -- HINT: DEFAULT_LOGGER is used to inherit sinks in newly created loggers.
+            // The new DEFAULT_LOGGER is not used by other threads yet.
+            SIMPLELOG_DIAG_TRACE0("ConfigTransaction: Create DEFAULT_LOGGER");
+            auto defaultLogger = makeLogger("");
+            defaultLogger->sinks().push_back(sinkSet);
+            ::spdlog::set_default_logger(defaultLogger);
+        }
+
+        // -- STEP 1+2: Compute the final config of each logger and
+        // publish the sinks of all loggers at once (one snapshot).
+        // HINT: Loggers that are created meanwhile wait for the new snapshot.
+        std::vector<std::pair<LoggerPtr, Level>> newLevels;
+        if (m_hasSinks) {
+            sinkSet->updateRoutes([&](SinkRoutes& routes) {
+                routes = computeConfig(routes, newLevels);
+            });
+        } else {
+            computeConfig(*sinkSet->getRoutes(), newLevels);
+        }
+        // -- STEP 3: Assign the levels (an atomic per logger).
+        for (const auto& item : newLevels) {
+            item.first->set_level(item.second);
+        }
+    }
+};
+
 /**
  * Assigns a new log-level to the logging subsystem and all existing loggers.
  * @note Newly created loggers will inherit this new default log-level.
@@ -44,14 +285,27 @@ inline void setLevel(const Level&  value)
 }
 
 /**
- * Apply a function-object to any logger that matches the predicate.
- * @param func      Function that operates on the the logger.
+ * Selects loggers with the predicate and applies the function-object to them
+ * (in one logging-registry pass).
+ * The callables are inlined (no std::function) and
+ * each logger is passed by reference (no shared_ptr copy).
+ *
+ * @code
+ *  using simplelog::backend_spdlog::LoggerPtr;
+ *  simplelog::backend_spdlog::selectAndApply(
+ *      [](const LoggerPtr& log) { return log->name().find("foo") == 0; },
+ *      [](const LoggerPtr& log) { log->set_level(SIMPLELOG_BACKEND_LEVEL_DEBUG); });
+ * @endcode
+ *
  * @param predicate Predicate function to select matching loggers.
+ * @param func      Function that operates on the the logger.
  * @note Uses logging-registry synchronized operation mechanism
- ***/
-inline void applyToAny(const LoggerFunc& func, const Predicate& predicate)
+ * @note spdlog::apply_all() itself uses one std::function call per logger.
+ **/
+template<typename PredicateT, typename FuncT>
+inline void selectAndApply(const PredicateT& predicate, const FuncT& func)
 {
-    ::spdlog::apply_all([&](LoggerPtr log) {
+    ::spdlog::apply_all([&](const LoggerPtr& log) {
         if (predicate(log)) {
             func(log);
         }
@@ -59,64 +313,107 @@ inline void applyToAny(const LoggerFunc& func, const Predicate& predicate)
 }
 
 /**
- * Assigns a new logging sink to any logger that matches the predicate.
- * @note Overrides and removes any pre-existing assigned sinks.
- **/
-inline void assignSinkToAny(SinkPtr sink, const Predicate& predicate)
+ * Apply a function-object to any logger that matches the predicate.
+ * @param func      Function that operates on the the logger.
+ * @param predicate Predicate function to select matching loggers.
+ * @note Uses logging-registry synchronized operation mechanism
+ * @see selectAndApply(predicate, func)
+ ***/
+template<typename FuncT, typename PredicateT>
+inline void applyToAny(const FuncT& func, const PredicateT& predicate)
 {
-    const auto clearAndAssignSink = [&](LoggerPtr log) {
-        auto& currentSinks = log->sinks();
-        currentSinks.clear();
-        currentSinks.push_back(sink);
-    };
-    applyToAny(clearAndAssignSink, predicate);
+    selectAndApply(predicate, func);
 }
 
 /**
- * Assigns a new logging sink to all loggers.
+ * Assigns a many logging sinks to any logger that matches the predicate.
  * @note Overrides and removes any pre-existing assigned sinks.
+ * @note Assigns the sinks of existing loggers: Use it during setup
+ *       (or use a ConfigTransaction while other threads log).
  **/
-inline void assignSink(SinkPtr sink)
+template<typename PredicateT>
+inline void assignSinksToAny(const Sinks& sinks, const PredicateT& predicate)
 {
-    // const auto matchesEachLogger = [](LoggerPtr) { return true; };
-    const auto& defaultLogger = spdlog::default_logger();
-    if (defaultLogger == nullptr) {
-        // -- HINT: Need DEFAULT_LOGGER 
-        // DEFAULT_LOGGER is used to inherit sinks in newly created loggers.
-        SIMPLELOG_DIAG_TRACE0("assignSink: Create DEFAULT_LOGGER");
-        spdlog::set_default_logger(makeLogger(""));
-    }
-    assignSinkToAny(sink, matchesEachLogger);
+    selectAndApply(predicate, [&](const LoggerPtr& log) {
+        log->sinks() = sinks;
+    });
 }
 
 /**
- * Assigns a many logging sinks to any logger that matches the predicate.
+ * Assigns a new logging sink to any logger that matches the predicate.
  * @note Overrides and removes any pre-existing assigned sinks.
+ * @see assignSinksToAny()
  **/
-inline void assignSinksToAny(const Sinks& sinks, const Predicate& predicate)
+template<typename PredicateT>
+inline void assignSinkToAny(SinkPtr sink, const PredicateT& predicate)
 {
-    const auto clearAndAssignSinks = [&](LoggerPtr log) {
-        auto& currentSinks = log->sinks();
-        currentSinks.clear();
-        currentSinks = sinks;
-    };
-    applyToAny(clearAndAssignSinks, predicate);
+    assignSinksToAny(Sinks{ std::move(sink) }, predicate);
 }
 
 /**
  * Assigns a many logging sinks to all loggers.
  * @note Overrides and removes any pre-existing assigned sinks.
+ * @see assignSinksToAny()
  **/
 inline void assignSinks(const Sinks& sinks)
 {
-    const auto& defaultLogger = spdlog::default_logger();
-    if (defaultLogger == nullptr) {
+    if (::spdlog::default_logger() == nullptr) {
+        // -- HINT: Need DEFAULT_LOGGER
+        // DEFAULT_LOGGER is used to inherit sinks in newly created loggers.
         SIMPLELOG_DIAG_TRACE0("assignSinks: Create DEFAULT_LOGGER");
-        spdlog::set_default_logger(makeLogger(""));
+        ::spdlog::set_default_logger(makeLogger(""));
     }
     assignSinksToAny(sinks, matchesEachLogger);
 }
 
+/**
+ * Assigns a new logging sink to all loggers.
+ * @note Overrides and removes any pre-existing assigned sinks.
+ * @see assignSinksToAny()
+ **/
+inline void assignSink(SinkPtr sink)
+{
+    assignSinks(Sinks{ std::move(sink) });
+}
+
+/**
+ * Assigns sinks to all loggers by using the shared sink set:
+ * All loggers use the SharedSinkSet as their only sink.
+ *
+ *   - FIRST USE: Assigns the SharedSinkSet to all loggers (and DEFAULT_LOGGER).
+ *   - OTHERWISE: Only swaps the sinks in the SharedSinkSet (no logger is changed).
+ *
+ * New loggers inherit the SharedSinkSet from the DEFAULT_LOGGER.
+ * @see getSharedSinkSet()
+ * @see useSharedSinkSet()
+ **/
+inline void assignSharedSinks(Sinks sinks)
+{
+    useSharedSinkSet();
+    getSharedSinkSet()->setSinks(std::move(sinks));
+}
+
+/**
+ * Assigns the formatter for this pattern to all existing loggers
+ * (and the DEFAULT_LOGGER for new loggers), like spdlog::set_pattern():
+ * The default pattern "%+" uses the CachedPrefixFormatter,
+ * any other pattern uses the spdlog::pattern_formatter.
+ * @note Replaces the formatter of all sinks: Pass the pattern of the application.
+ * @see makeCachedPrefixFormatter()
+ **/
+inline void setCachedPrefixFormatter(const std::string& pattern,
+    ::spdlog::pattern_time_type timeType = ::spdlog::pattern_time_type::local)
+{
+    ::spdlog::set_formatter(makeCachedPrefixFormatter(pattern, timeType));
+}
+
+//! Assigns the CachedPrefixFormatter (default pattern "%+") to all loggers.
+inline void setCachedPrefixFormatter(
+    ::spdlog::pattern_time_type timeType = ::spdlog::pattern_time_type::local)
+{
+    setCachedPrefixFormatter("%+", timeType);
+}
+
 /**
  * Assign log-level to any loggers where predicate(logger) is true.
  * 
@@ -145,12 +442,13 @@ inline void assignSinks(const Sinks& sinks)
  *  }
  * @endcode
  **/
-inline void setLevelToAny(Level level, const Predicate& predicate)
+template<typename PredicateT>
+inline void setLevelToAny(Level level, const PredicateT& predicate)
 {
-    const auto& assignThisLevel = [=](LoggerPtr log) {
+    // -- HINT: Level is an atomic per logger (no ConfigTransaction needed).
+    selectAndApply(predicate, [level](const LoggerPtr& log) {
         log->set_level(level);
-    };
-    applyToAny(assignThisLevel, predicate);
+    });
 }
 
 /**
@@ -180,15 +478,260 @@ inline void setLevelToAny(Level level, const Predicate& predicate)
  **/
 inline void setMinLevel(const Level& minLevel)
 {
-    const auto hasLoggerLessThanMinLevel = [=](LoggerPtr log) {
-        return log && (log->level() < minLevel);
-    };
-    const auto assignMinLevel = [=](LoggerPtr log) {
-        // SIMPLELOG_DIAG_TRACE("setMinLevel: log={0} from {1} to {2}", log->name(), log->level(), minLevel);
-        log->set_level(minLevel);
+    ::spdlog::apply_all([minLevel](const LoggerPtr& log) {
+        if (log->level() < minLevel) {
+            log->set_level(minLevel);
+        }
+    });
+}
+
+// --------------------------------------------------------------------------
+// LEVEL CONFIG: Apply a LevelConfig (as read from a config file).
+// --------------------------------------------------------------------------
+using LevelConfig = simplelog::backend_common::LevelConfig;
+using NamedSinks = std::map<std::string, SinkPtr>;
+
+/**
+ * Converts a level name into a log-level (as: "debug", "warn", "err", "off").
+ * @return true, if the level name is known. Otherwise, false.
+ * @see simplelog::backend_common::parseLevelSeverity() (for the level names)
+ **/
+inline bool parseLevel(std::string_view name, Level& level)
+{
+    using simplelog::backend_common::LevelSeverity;
+    static constexpr Level levels[] = {
+        ::spdlog::level::trace,     //< Trace
+        ::spdlog::level::debug,     //< Debug
+        ::spdlog::level::info,      //< Info
+        ::spdlog::level::info,      //< Notice
+        ::spdlog::level::warn,      //< Warning
+        ::spdlog::level::err,       //< Error
+        ::spdlog::level::critical,  //< Critical
+        ::spdlog::level::critical,  //< Alert
+        ::spdlog::level::critical,  //< Emergency
+        ::spdlog::level::off        //< Off
     };
-    applyToAny(assignMinLevel, hasLoggerLessThanMinLevel);
-    // setLevelToAny(minLevel, hasLoggerLessThanMinLevel);
+    LevelSeverity severity;
+    if (!simplelog::backend_common::parseLevelSeverity(name, severity)) {
+        return false;
+    }
+    level = levels[static_cast<int>(severity)];
+    return true;
+}
+
+/**
+ * Converts a LevelConfig into LevelConfigRules (one rule per valid entry).
+ * Entries with unknown level name are ignored.
+ * Sink names are looked up in the sinks (unknown sink names are ignored).
+ **/
+inline std::vector<LevelConfigRule> makeLevelConfigRules(const LevelConfig& config,
+                                                         const NamedSinks& sinks = NamedSinks())
+{
+    std::vector<LevelConfigRule> rules;
+    for (const auto& entry : config) {
+        Level level;
+        if (!parseLevel(entry.level, level)) {
+            SIMPLELOG_DIAG_TRACE("makeLevelConfigRules: IGNORED {0}={1} (unknown level)",
+                                 entry.pattern, entry.level);
+            continue;
+        }
+        Sinks selectedSinks;
+        for (const auto& sinkName : entry.sinkNames) {
+            const auto sinkIter = sinks.find(sinkName);
+            if (sinkIter != sinks.end()) {
+                selectedSinks.push_back(sinkIter->second);
+            }
+        }
+        rules.push_back(LevelConfigRule{ entry.pattern, level, std::move(selectedSinks) });
+    }
+    return rules;
+}
+
+//! Stages LevelConfigRules in a ConfigTransaction (for the existing loggers).
+inline ConfigTransaction& stageLevelConfigRules(ConfigTransaction& transaction,
+                                                const std::vector<LevelConfigRule>& rules)
+{
+    using simplelog::backend_common::matchesModulePattern;
+    for (const auto& rule : rules) {
+        const auto matchesPattern = [pattern = rule.pattern](const LoggerPtr& log) {
+            return matchesModulePattern(pattern, log->name());
+        };
+        transaction.setLevelToAny(rule.level, matchesPattern);
+        if (!rule.sinks.empty()) {
+            transaction.assignSinksToAny(rule.sinks, matchesPattern);
+        }
+    }
+    return transaction;
+}
+
+/**
+ * Stages a LevelConfig in a ConfigTransaction.
+ * Entries with unknown level name are ignored.
+ * Sink names are looked up in the sinks (unknown sink names are ignored).
+ * @note Affects only the existing loggers (see: applyLevelConfig()).
+ **/
+inline ConfigTransaction& stageLevelConfig(ConfigTransaction& transaction,
+                                           const LevelConfig& config,
+                                           const NamedSinks& sinks = NamedSinks())
+{
+    return stageLevelConfigRules(transaction, makeLevelConfigRules(config, sinks));
+}
+
+namespace detail {
+
+//! Indicates if any rule selects sinks.
+inline bool selectsSinks(const std::vector<LevelConfigRule>& rules)
+{
+    return std::any_of(rules.begin(), rules.end(), [](const LevelConfigRule& rule) {
+        return !rule.sinks.empty();
+    });
+}
+
+} //< NAMESPACE-END: detail
+
+/**
+ * Applies a LevelConfig to all existing loggers (as one ConfigTransaction)
+ * and to the loggers that are created later (replaces the previous config).
+ *
+ * If an entry selects sinks, all loggers use the SharedSinkSet
+ * (see: useSharedSinkSet()). Therefore, the sinks of existing loggers are changed, too.
+ * @note Select sinks the first time during the setup (or call useSharedSinkSet() then).
+ *
+ * @code
+ *  using simplelog::backend_common::readLevelConfigFile;
+ *  simplelog::backend_spdlog::applyLevelConfig(readLevelConfigFile("logging.conf"),
+ *      {{"console", consoleSink}, {"file", fileSink}});
+ * @endcode
+ * @see simplelog::backend_common::ConfigFileWatcher (for hot-reload)
+ **/
+inline void applyLevelConfig(const LevelConfig& config,
+                             const NamedSinks& sinks = NamedSinks())
+{
+    auto rules = makeLevelConfigRules(config, sinks);
+    if (detail::selectsSinks(rules)) {
+        useSharedSinkSet();
+    }
+    getLevelConfigRules().setRules(rules);
+    ConfigTransaction transaction;
+    stageLevelConfigRules(transaction, rules).commit();
+}
+
+/**
+ * Adds a LevelConfig to the applied config (as: one changed entry).
+ * Is applied to all existing loggers and to the loggers that are created later.
+ * @see applyLevelConfig() (for selected sinks)
+ **/
+inline void addLevelConfig(const LevelConfig& config,
+                           const NamedSinks& sinks = NamedSinks())
+{
+    const auto rules = makeLevelConfigRules(config, sinks);
+    if (detail::selectsSinks(rules)) {
+        useSharedSinkSet();
+    }
+    getLevelConfigRules().addRules(rules);
+    ConfigTransaction transaction;
+    stageLevelConfigRules(transaction, rules).commit();
+}
+
+// --------------------------------------------------------------------------
+// ASYNC MODE: Log-records are written to the sinks by a thread pool.
+// --------------------------------------------------------------------------
+using OverflowPolicy = ::spdlog::async_overflow_policy;
+
+//! Indicates if the logger is an async logger.
+inline bool isAsyncLogger(const LoggerPtr& log)
+{
+    return std::dynamic_pointer_cast<::spdlog::async_logger>(log) != nullptr;
+}
+
+/**
+ * Creates an async logger with the config of another logger (sinks, level, ...).
+ * @note The async logger uses the current spdlog thread pool.
+ **/
+inline LoggerPtr makeAsyncLogger(const LoggerPtr& log, OverflowPolicy policy)
+{
+    auto asyncLog = std::make_shared<::spdlog::async_logger>(log->name(),
+        log->sinks().begin(), log->sinks().end(), ::spdlog::thread_pool(), policy);
+    asyncLog->set_level(log->level());
+    asyncLog->flush_on(log->flush_level());
+    return asyncLog;
+}
+
+/**
+ * Switches the logging subsystem into async mode:
+ *
+ *   - Creates the spdlog thread pool (with queue size and number of threads).
+ *   - Replaces each registered logger with an async logger (same config).
+ *   - Replaces the DEFAULT_LOGGER with an async logger.
+ *     Loggers that are created later by useOrCreateLogger() are cloned
+ *     from the DEFAULT_LOGGER (and therefore are async loggers, too).
+ *
+ * @param queueSize  Max. number of queued log-records (of all loggers).
+ * @param threads    Number of worker threads.
+ *                   Log-records of a logger keep their order with 1 thread only.
+ * @param policy     What to do if the queue is full (block, overrun_oldest, ...).
+ * @return true, on success. false, if the spdlog thread pool exists already
+ *         (as: setupAsync() was called before without shutdownAsync())
+ *         or a pattern uses the diagnostic context flag "%*"
+ *         (the worker thread would render an empty context).
+ *
+ * @note Call this function during the setup of the logging subsystem.
+ *       The pinned loggers are replaced (useOrCreateLoggerHandle() returns
+ *       the async logger). Logger copies that were taken before
+ *       (static modules, LoggerHandle) still use the old (synchronous) logger.
+ * @see shutdownAsync()
+ **/
+inline bool setupAsync(std::size_t queueSize = 8192, std::size_t threads = 1,
+                       OverflowPolicy policy = OverflowPolicy::block)
+{
+    if (::spdlog::thread_pool()) {
+        // -- HINT: Replacing the thread pool would orphan the queued log-records
+        // of the existing async loggers (they keep a weak_ptr to the old pool).
+        SIMPLELOG_DIAG_TRACE0("setupAsync: REJECTED (thread pool exists already)");
+        return false;
+    }
+    if (DiagnosticContextFlag::isUsed()) {
+        SIMPLELOG_DIAG_TRACE0("setupAsync: REJECTED (pattern uses diagnostic context)");
+        return false;
+    }
+
+    // -- HINT: Loggers can not be replaced in spdlog::apply_all() (DEADLOCK).
+    std::vector<LoggerPtr> loggers;
+    ::spdlog::apply_all([&](const LoggerPtr& log) {
+        loggers.push_back(log);
+    });
+
+    ::spdlog::init_thread_pool(queueSize, threads);
+    const auto defaultLogger = ::spdlog::default_logger();
+    if (!defaultLogger) {
+        ::spdlog::set_default_logger(makeAsyncLogger(makeLogger(""), policy));
+    }
+    for (const auto& log : loggers) {
+        auto asyncLog = makeAsyncLogger(log, policy);
+        if (log == defaultLogger) {
+            ::spdlog::set_default_logger(asyncLog);
+        } else {
+            ::spdlog::drop(log->name());
+            ::spdlog::register_logger(asyncLog);
+        }
+        getLoggerHandleRegistry().replaceLogger(asyncLog);
+        SIMPLELOG_DIAG_TRACE("setupAsync: Replaced log={0} with async logger",
+            (log->name().empty() ? std::string("DEFAULT_LOGGER") : log->name()));
+    }
+    invalidateLoggerCaches();
+    return true;
+}
+
+/**
+ * Writes all queued log-records, stops the thread pool and drops all loggers.
+ * @note Call this function before the program exits (in async mode).
+ * @see spdlog::shutdown()
+ **/
+inline void shutdownAsync()
+{
+    getLoggerHandleRegistry().clear();
+    ::spdlog::shutdown();   //< Drains queue when thread pool is destroyed.
+    invalidateLoggerCaches();
 }
 
 /**
@@ -236,13 +779,12 @@ selectLoggersByName(const std::string& pattern)
  * @note Logging registry multi-threading protection mechanism is no longer available
  * @see applyToAny(func, predicate)
  **/ 
-inline std::vector<LoggerPtr> selectLoggers(const Predicate& predicate)
+template<typename PredicateT>
+inline std::vector<LoggerPtr> selectLoggers(const PredicateT& predicate)
 {
     std::vector<LoggerPtr> selected;
-    ::spdlog::apply_all([&](LoggerPtr log) {
-        if (predicate(log)) {
-            selected.push_back(log);
-        };
+    selectAndApply(predicate, [&](const LoggerPtr& log) {
+        selected.push_back(log);
     });
     return selected;
 }
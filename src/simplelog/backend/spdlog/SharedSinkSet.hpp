@@ -0,0 +1,299 @@
+/**
+ * @file simplelog/backend/spdlog/SharedSinkSet.hpp
+ * Provides one sink set that is shared by many loggers (and can be swapped).
+ *
+ * Each logger uses the SharedSinkSet as its only sink.
+ * Retargeting the output of all loggers is one pointer swap
+ * (instead of copying the sinks into each logger).
+ * The SinkRoutes snapshot can select other sinks for some loggers (by name).
+ *
+ * @see https://github.com/gabime/spdlog/wiki/4.-Sinks
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/sink.h>
+#include <spdlog/formatter.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>   //< USE: std::less<>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND: SHARED SINK SET
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_spdlog {
+
+namespace detail {
+
+/**
+ * @class SnapshotReaders
+ * Tracks the readers of an immutable snapshot (RCU-style, epoch-protected).
+ *
+ * A reader increments a counter of the current epoch parity before it loads
+ * the snapshot pointer (and decrements it when done). Each thread uses its
+ * own counter stripe (cache-line). Therefore, readers of different threads
+ * do not contend (no shared mutex, no shared refcount).
+ *
+ * The writer publishes a new snapshot, then flips the epoch parity twice and
+ * waits until the readers of each parity left (grace period).
+ * Afterwards, no reader uses the old snapshot (and it can be released).
+ *
+ * @note A reader must not call synchronize() (self-deadlock).
+ **/
+class SnapshotReaders
+{
+public:
+    static constexpr std::size_t STRIPES = 16;
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+    using Counter = std::atomic<std::uint32_t>;
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Stripe
+    {
+        Counter readers{0};
+    };
+    Stripe m_stripes[2][STRIPES];   //< INDEX: [epoch parity][thread stripe]
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> m_epoch{0};
+
+    static std::size_t getThreadStripe()
+    {
+        static std::atomic<std::size_t> theNextStripe(0);
+        thread_local const std::size_t theStripe =
+            theNextStripe.fetch_add(1, std::memory_order_relaxed) % STRIPES;
+        return theStripe;
+    }
+
+public:
+    //! Marks the begin of a read (before the snapshot pointer is loaded).
+    Counter& enter()
+    {
+        const auto parity = m_epoch.load() & 1u;
+        Counter& counter = m_stripes[parity][getThreadStripe()].readers;
+        counter.fetch_add(1);   //< SEQ_CST: Is ordered before the snapshot load.
+        return counter;
+    }
+
+    //! Marks the end of a read (the snapshot is no longer used).
+    static void leave(Counter& counter)
+    {
+        counter.fetch_sub(1, std::memory_order_release);
+    }
+
+    //! Waits until no reader uses a snapshot that was replaced before.
+    void synchronize()
+    {
+        for (int flip = 0; flip < 2; ++flip) {
+            const auto parity = m_epoch.fetch_add(1) & 1u;
+            for (auto& stripe : m_stripes[parity]) {
+                while (stripe.readers.load() != 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+};
+
+} //< NAMESPACE-END: detail
+
+/**
+ * @struct SinkRoutes
+ * Immutable sinks config of all loggers that use the SharedSinkSet:
+ * The default sinks and the sinks of some loggers (selected by logger name).
+ **/
+struct SinkRoutes
+{
+    using Sinks = std::vector<::spdlog::sink_ptr>;
+    using LoggerSinks = std::map<std::string, Sinks, std::less<>>;
+
+    Sinks sinks;                //< DEFAULT: Used by any other logger.
+    LoggerSinks loggerSinks;    //< KEY: Logger name.
+
+    //! Returns the sinks of this logger.
+    const Sinks& findSinks(std::string_view loggerName) const
+    {
+        if (!loggerSinks.empty()) {
+            const auto iter = loggerSinks.find(loggerName);
+            if (iter != loggerSinks.end()) {
+                return iter->second;
+            }
+        }
+        return sinks;
+    }
+
+    //! Applies the function to each sink (a sink may be passed more than once).
+    template<typename FuncT>
+    void forEachSink(const FuncT& func) const
+    {
+        for (const auto& sink : sinks) {
+            func(sink);
+        }
+        for (const auto& item : loggerSinks) {
+            for (const auto& sink : item.second) {
+                func(sink);
+            }
+        }
+    }
+};
+
+/**
+ * @class SharedSinkSet
+ * Sink that forwards each log-record to the current sinks of its logger.
+ * The sinks config (SinkRoutes) is immutable and swapped atomically
+ * with setSinks() or setRoutes().
+ *
+ * Logging threads read the current SinkRoutes without a mutex and without
+ * a shared refcount: A reader counter (on the cache-line of its thread stripe)
+ * protects the raw snapshot pointer (see: detail::SnapshotReaders).
+ * setRoutes() waits for a grace period before the old snapshot is released.
+ *
+ * @note The forwarded-to sinks use their own mutex (as: "*_mt" sinks).
+ * @note Do not call setRoutes() from a sink that is used by this sink set.
+ **/
+class SharedSinkSet : public ::spdlog::sinks::sink
+{
+public:
+    using SinkPtr = ::spdlog::sink_ptr;
+    using Sinks = std::vector<SinkPtr>;
+    using RoutesPtr = std::shared_ptr<const SinkRoutes>;
+
+private:
+    std::atomic<const SinkRoutes*> m_current;   //< Read by logging threads.
+    RoutesPtr m_routes;                         //< Owns the current snapshot.
+    mutable detail::SnapshotReaders m_readers;
+    mutable std::mutex m_mutex;                 //< Serializes writers (only).
+
+    /**
+     * @class ReadGuard
+     * Provides the current SinkRoutes (while the guard exists).
+     **/
+    class ReadGuard
+    {
+    private:
+        detail::SnapshotReaders::Counter& m_counter;
+        const SinkRoutes* m_routes;
+
+    public:
+        explicit ReadGuard(const SharedSinkSet& sinkSet)
+            : m_counter(sinkSet.m_readers.enter()),
+              m_routes(sinkSet.m_current.load())
+        {}
+        ~ReadGuard() { detail::SnapshotReaders::leave(m_counter); }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        const SinkRoutes* operator->() const { return m_routes; }
+    };
+
+public:
+    SharedSinkSet() : SharedSinkSet(Sinks()) {}
+    explicit SharedSinkSet(Sinks sinks)
+        : m_current(nullptr),
+          m_routes(std::make_shared<const SinkRoutes>(SinkRoutes{std::move(sinks), {}})),
+          m_readers(), m_mutex()
+    {
+        m_current.store(m_routes.get());
+    }
+
+    //! Returns the current sinks config (as snapshot).
+    RoutesPtr getRoutes() const
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_routes;
+    }
+
+    //! Returns the current sinks of this logger (or the default sinks).
+    Sinks getSinks(std::string_view loggerName = std::string_view()) const
+    {
+        return getRoutes()->findSinks(loggerName);
+    }
+
+    //! Swaps the sinks config (used by all loggers with this sink).
+    void setRoutes(SinkRoutes routes)
+    {
+        auto newRoutes = std::make_shared<const SinkRoutes>(std::move(routes));
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_current.store(newRoutes.get());
+        m_readers.synchronize();    //< GRACE PERIOD: Old snapshot is unused now.
+        m_routes = std::move(newRoutes);
+    }
+
+    /**
+     * Changes a copy of the current sinks config and swaps it.
+     * Concurrent updates are serialized (no update is lost).
+     **/
+    template<typename FuncT>
+    void updateRoutes(const FuncT& func)
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto newRoutes = std::make_shared<SinkRoutes>(*m_routes);
+        func(*newRoutes);
+        m_current.store(newRoutes.get());
+        m_readers.synchronize();    //< GRACE PERIOD: Old snapshot is unused now.
+        m_routes = std::move(newRoutes);
+    }
+
+    //! Swaps the sinks of all loggers (and removes the sinks per logger).
+    void setSinks(Sinks sinks)
+    {
+        setRoutes(SinkRoutes{std::move(sinks), {}});
+    }
+
+    void log(const ::spdlog::details::log_msg& msg) override
+    {
+        const ReadGuard routes(*this);
+        const auto& sinks = routes->findSinks(
+            std::string_view(msg.logger_name.data(), msg.logger_name.size()));
+        for (const auto& sink : sinks) {
+            if (sink->should_log(msg.level)) {
+                sink->log(msg);
+            }
+        }
+    }
+
+    void flush() override
+    {
+        const ReadGuard routes(*this);
+        routes->forEachSink([](const SinkPtr& sink) {
+            sink->flush();
+        });
+    }
+
+    void set_pattern(const std::string& pattern) override
+    {
+        const ReadGuard routes(*this);
+        routes->forEachSink([&](const SinkPtr& sink) {
+            sink->set_pattern(pattern);
+        });
+    }
+
+    void set_formatter(std::unique_ptr<::spdlog::formatter> formatter) override
+    {
+        const ReadGuard routes(*this);
+        routes->forEachSink([&](const SinkPtr& sink) {
+            sink->set_formatter(formatter->clone());
+        });
+    }
+};
+
+//! Provides the SharedSinkSet that is used by assignSharedSinks() and ConfigTransaction.
+inline const std::shared_ptr<SharedSinkSet>& getSharedSinkSet()
+{
+    static const auto theSinkSet = std::make_shared<SharedSinkSet>();
+    return theSinkSet;
+}
+
+}} //< NAMESPACE-END: simplelog::backend_spdlog
@@ -0,0 +1,101 @@
+/**
+ * @file simplelog/backend/spdlog/ThreadLevelOverride.hpp
+ * Provides per-thread level overrides for spdlog loggers.
+ *
+ * @see simplelog/backend/common/ThreadLevelOverride.hpp
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include "simplelog/backend/common/ThreadLevelOverride.hpp"
+#include <spdlog/spdlog.h>
+#include <spdlog/logger.h>
+#include <spdlog/fmt/fmt.h>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND: THREAD LEVEL OVERRIDES
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_spdlog {
+
+using ThreadLevelOverrideScope = simplelog::backend_common::ThreadLevelOverrideScope;
+
+/**
+ * Checks if a log-record is enabled by a level override of the current thread.
+ * @note SLOW PATH: Only used if the logger level disables this log-record.
+ **/
+template<typename LoggerT>
+inline bool isLevelEnabledForThisThread(const LoggerT& logger, ::spdlog::level::level_enum level)
+{
+    int overrideLevel = 0;
+    return simplelog::backend_common::hasThreadLevelOverrides() &&
+           simplelog::backend_common::findThreadLevelOverride(logger->name(), overrideLevel) &&
+           (static_cast<int>(level) >= overrideLevel);
+}
+
+namespace detail {
+
+/**
+ * @class LoggerAccess
+ * Passes a log-record to a logger (as the logger does after its level check).
+ * Therefore, the async mode, the record counter (CountingLogger)
+ * and the error handler of the logger still apply.
+ **/
+class LoggerAccess : public ::spdlog::logger
+{
+public:
+    static void logIt(::spdlog::logger& logger, const ::spdlog::details::log_msg& message)
+    {
+        // -- HINT: Protected member is accessed with a member pointer of this class.
+        const auto logIt = &LoggerAccess::log_it_;
+        (logger.*logIt)(message, true, logger.should_backtrace());
+    }
+};
+
+inline void logToLogger(::spdlog::logger& logger, ::spdlog::source_loc location,
+                        ::spdlog::level::level_enum level, std::string_view text)
+{
+    // -- HINT: Bypasses the logger level (but not the sink level).
+    const ::spdlog::details::log_msg message(location, logger.name(), level,
+        ::spdlog::string_view_t(text.data(), text.size()));
+    LoggerAccess::logIt(logger, message);
+}
+
+template<typename T>
+inline std::string toMessageText(const T& message)
+{
+    if constexpr (std::is_convertible<const T&, std::string_view>::value) {
+        return std::string(std::string_view(message));
+    } else {
+        return fmt::format("{}", message);
+    }
+}
+
+} //< NAMESPACE-END: detail
+
+/**
+ * Logs a log-record that is only enabled by a thread level override.
+ * @note The format string was already checked at compile-time
+ *       by the normal logger->log() call in SIMPLELOG_BACKEND_LOG().
+ **/
+template<typename LoggerT, typename T>
+inline void logForThisThread(const LoggerT& logger, ::spdlog::source_loc location,
+                             ::spdlog::level::level_enum level, const T& message)
+{
+    detail::logToLogger(*logger, location, level, detail::toMessageText(message));
+}
+
+template<typename LoggerT, typename FormatT, typename Arg1, typename... Args>
+inline void logForThisThread(const LoggerT& logger, ::spdlog::source_loc location,
+                             ::spdlog::level::level_enum level, const FormatT& format,
+                             const Arg1& arg1, const Args&... args)
+{
+    const auto text = fmt::vformat(std::string_view(format), fmt::make_format_args(arg1, args...));
+    detail::logToLogger(*logger, location, level, text);
+}
+
+}} //< NAMESPACE-END: simplelog::backend_spdlog
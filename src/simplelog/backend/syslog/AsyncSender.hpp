@@ -0,0 +1,321 @@
+/**
+ * @file simplelog/backend/syslog/AsyncSender.hpp
+ * Provides the async mode for the syslog backend (sender thread).
+ *
+ * In async mode, Module::log() only enqueues the formatted log-record
+ * into a bounded queue. A sender thread sends the queued log-records
+ * in batches (with the SyslogTransport: one sendmmsg() per batch).
+ * Therefore, a slow syslog daemon does not stall the logging threads.
+ *
+ * @code
+ *  simplelog::backend_syslog::setupAsync(8192, AsyncOverflowPolicy::DropNewest);
+ *  ...
+ *  simplelog::backend_syslog::shutdownAsync();     //< Sends queued log-records.
+ * @endcode
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include "simplelog/backend/syslog/Transport.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <syslog.h>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND: ASYNC SENDER
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_syslog {
+
+//! What to do if the queue is full.
+enum class AsyncOverflowPolicy
+{
+    Block,          //< Wait until the sender thread made room.
+    DropNewest,     //< Drop the new log-record.
+    DropOldest      //< Drop the oldest queued log-record.
+};
+
+/**
+ * @class AsyncSender
+ * Bounded queue of formatted log-records and its sender thread.
+ * The timestamp of a log-record is taken when it is enqueued
+ * (not when the sender thread sends it).
+ * @note Queued records keep their string capacity (no allocation when warm).
+ **/
+class AsyncSender
+{
+public:
+    static constexpr std::size_t DEFAULT_QUEUE_SIZE = 8192;
+    static constexpr std::size_t DEFAULT_BATCH_SIZE = 64;
+    using Clock = SyslogEncoder::Clock;
+
+    struct Record
+    {
+        int level;
+        Clock::time_point time;     //< When the log-record was enqueued.
+        std::string text;
+    };
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+    std::vector<Record> m_queue;    //< RING-BUFFER
+    std::size_t m_head;
+    std::size_t m_size;
+    std::vector<Record> m_sending;  //< Batch of the sender thread.
+    bool m_busy;
+    bool m_stopped;
+    AsyncOverflowPolicy m_policy;
+    std::size_t m_batchSize;
+    SyslogTransportPtr m_transport;
+    std::atomic<std::size_t> m_droppedCount;
+    std::atomic<std::size_t> m_sentCount;
+    std::thread m_thread;
+
+public:
+    /**
+     * Creates the queue and starts the sender thread.
+     * @param transport  Transport to use (or nullptr: use the current one or syslog()).
+     **/
+    explicit AsyncSender(std::size_t queueSize = DEFAULT_QUEUE_SIZE,
+                         AsyncOverflowPolicy policy = AsyncOverflowPolicy::Block,
+                         SyslogTransportPtr transport = SyslogTransportPtr(),
+                         std::size_t batchSize = DEFAULT_BATCH_SIZE)
+        : m_queue(std::max<std::size_t>(queueSize, 1)),
+          m_head(0),
+          m_size(0),
+          m_sending(),
+          m_busy(false),
+          m_stopped(false),
+          m_policy(policy),
+          m_batchSize(std::max<std::size_t>(batchSize, 1)),
+          m_transport(std::move(transport)),
+          m_droppedCount(0),
+          m_sentCount(0),
+          m_thread()
+    {
+        m_sending.reserve(m_batchSize);
+        m_thread = std::thread([this]() { run(); });
+    }
+
+    ~AsyncSender()
+    {
+        stop();
+    }
+
+    AsyncSender(const AsyncSender&) = delete;
+    AsyncSender& operator=(const AsyncSender&) = delete;
+
+    AsyncOverflowPolicy getPolicy() const { return m_policy; }
+    std::size_t getQueueSize() const { return m_queue.size(); }
+    std::size_t getDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+    //! Number of sent log-records (as reported by the transport).
+    std::size_t getSentCount() const { return m_sentCount.load(std::memory_order_relaxed); }
+
+    //! Number of queued log-records (not taken by the sender thread yet).
+    std::size_t getQueuedCount()
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_size;
+    }
+
+    /**
+     * Enqueues a formatted log-record (for the sender thread).
+     * @param time  Timestamp of the log-record (default: now).
+     * @return true, if enqueued. Otherwise, false (dropped).
+     * @note After stop(): The log-record is sent directly.
+     **/
+    bool enqueue(int level, std::string_view text, Clock::time_point time = Clock::now())
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_stopped) {
+            lock.unlock();
+            sendNow(level, text, time);
+            return true;
+        }
+        if (m_size == m_queue.size()) {
+            if (m_policy == AsyncOverflowPolicy::DropNewest) {
+                m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else if (m_policy == AsyncOverflowPolicy::DropOldest) {
+                m_head = (m_head + 1) % m_queue.size();
+                --m_size;
+                m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                m_notFull.wait(lock, [this]() { return (m_size < m_queue.size()) || m_stopped; });
+                if (m_stopped) {
+                    lock.unlock();
+                    sendNow(level, text, time);
+                    return true;
+                }
+            }
+        }
+        auto& record = m_queue[(m_head + m_size) % m_queue.size()];
+        record.level = level;
+        record.time = time;
+        record.text.assign(text.data(), text.size());
+        ++m_size;
+        lock.unlock();
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    //! Waits until all queued log-records are sent.
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [this]() { return ((m_size == 0) && !m_busy) || m_stopped; });
+    }
+
+    //! Sends the queued log-records and stops the sender thread.
+    void stop()
+    {
+        {
+            // -- CRITICAL-SECTION
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stopped) {
+                return;
+            }
+            m_stopped = true;
+        }
+        m_notEmpty.notify_all();
+        m_notFull.notify_all();
+        m_thread.join();
+    }
+
+private:
+    //! Returns the transport to use (shared owner: while it is used).
+    SyslogTransportPtr getTransport() const
+    {
+        return m_transport ? m_transport : getSyslogTransportPtr();
+    }
+
+    void sendNow(int level, std::string_view text, Clock::time_point time)
+    {
+        if (auto transport = getTransport()) {
+            if (!transport->send(level, text, time)) {
+                return;     //< NOT SENT: Is not counted.
+            }
+        } else {
+            // -- HINT: syslog() uses its own timestamp.
+            syslog(level, "%.*s", static_cast<int>(text.size()), text.data());
+        }
+        m_sentCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void sendBatch()
+    {
+        if (auto transport = getTransport()) {
+            SyslogBatch batch;
+            for (const auto& record : m_sending) {
+                batch.add(transport->getEncoder(), record.level, record.text, record.time);
+            }
+            const auto sentCount = transport->send(batch);
+            m_sentCount.fetch_add(sentCount, std::memory_order_relaxed);
+        } else {
+            for (const auto& record : m_sending) {
+                sendNow(record.level, record.text, record.time);
+            }
+        }
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_notEmpty.wait(lock, [this]() { return (m_size > 0) || m_stopped; });
+            if (m_size == 0) {
+                break;  //< STOPPED: And queue is drained.
+            }
+            // -- TAKE BATCH: Swap strings (keeps their capacity in both places).
+            const auto count = std::min(m_size, m_batchSize);
+            m_sending.resize(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                auto& record = m_queue[(m_head + i) % m_queue.size()];
+                m_sending[i].level = record.level;
+                m_sending[i].time = record.time;
+                m_sending[i].text.swap(record.text);
+            }
+            m_head = (m_head + count) % m_queue.size();
+            m_size -= count;
+            m_busy = true;
+            lock.unlock();
+            m_notFull.notify_all();
+            sendBatch();
+            lock.lock();
+            m_busy = false;
+            m_notFull.notify_all();
+        }
+    }
+};
+
+using AsyncSenderPtr = std::shared_ptr<AsyncSender>;
+
+namespace detail {
+
+inline std::atomic<AsyncSender*> currentAsyncSender(nullptr);
+
+/**
+ * @struct PinnedAsyncSenders
+ * Keeps all used senders alive (modules use the raw pointer).
+ * At the program end: Disables the async mode before the senders are stopped
+ * (they send their queued log-records) and released.
+ **/
+struct PinnedAsyncSenders
+{
+    std::vector<AsyncSenderPtr> senders;
+
+    ~PinnedAsyncSenders()
+    {
+        currentAsyncSender.store(nullptr, std::memory_order_release);
+        for (const auto& sender : senders) {
+            sender->stop();
+        }
+    }
+};
+
+inline std::vector<AsyncSenderPtr>& getPinnedAsyncSenders()
+{
+    static PinnedAsyncSenders thePinned;
+    return thePinned.senders;
+}
+
+} //< NAMESPACE-END: detail
+
+/**
+ * Uses this AsyncSender for all modules (async mode).
+ * @param sender  Sender to use (or nullptr: Disables the async mode).
+ * @note A replaced sender is stopped, but kept alive (until the program ends).
+ **/
+inline void useAsyncSender(AsyncSenderPtr sender)
+{
+    static std::mutex theMutex;
+    // -- CRITICAL-SECTION
+    std::lock_guard<std::mutex> lock(theMutex);
+    if (sender) {
+        detail::getPinnedAsyncSenders().push_back(sender);
+    }
+    auto* oldSender = detail::currentAsyncSender.exchange(sender.get(), std::memory_order_acq_rel);
+    if (oldSender && (oldSender != sender.get())) {
+        oldSender->stop();
+    }
+}
+
+//! Returns the used AsyncSender (or nullptr if the async mode is disabled).
+inline AsyncSender* getAsyncSender()
+{
+    return detail::currentAsyncSender.load(std::memory_order_acquire);
+}
+
+}} //< NAMESPACE-END: simplelog::backend_syslog
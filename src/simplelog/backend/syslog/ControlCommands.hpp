@@ -0,0 +1,73 @@
+/**
+ * @file simplelog/backend/syslog/ControlCommands.hpp
+ * Provides the control commands for syslog modules (for a ControlServer).
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include "simplelog/backend/common/ControlServer.hpp"
+#include "simplelog/backend/syslog/SetupUtil.hpp"
+#include <string>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND CONTROL COMMANDS
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_syslog {
+
+using ControlServer = simplelog::backend_common::ControlServer;
+
+/**
+ * Registers the logging control commands in a ControlServer:
+ *
+ *   - set <module_pattern> <level>
+ *   - list   (shows: <module_name> <level> <counter>)
+ *   - flush  (nothing to do: syslog() sends each record immediately)
+ *   - dump   (flight recorders of all threads)
+ *
+ * The set command is added to the applied LevelConfig (see: addLevelConfig()).
+ * Therefore, it is also used for modules that are created later.
+ * @note The server thread only changes the module level (an atomic).
+ **/
+inline void addControlCommands(ControlServer& server,
+                               ModuleRegistry& registry = getModuleRegistry())
+{
+    using Arguments = ControlServer::Arguments;
+    server.addCommand("set", "set <module_pattern> <level>",
+        [&registry](const Arguments& args) -> std::string {
+            int level;
+            if (args.size() != 2) {
+                return "ERROR: Wrong args (expected: <module_pattern> <level>)\n";
+            }
+            if (!parseLevel(args[1], level)) {
+                return "ERROR: Unknown level: " + args[1] + "\n";
+            }
+            addLevelConfig(registry, {{args[0], args[1], {}}});
+            return "OK\n";
+        });
+
+    server.addCommand("list", "list",
+        [&registry](const Arguments&) -> std::string {
+            std::string text;
+            registry.applyToModules([&](ModulePtr module) {
+                text += (module->getName().empty() ? "<default>" : module->getName()) +
+                        " " + std::to_string(module->getLevel()) +
+                        " " + std::to_string(module->getCounter()) + "\n";
+            });
+            return text;
+        });
+
+    server.addCommand("flush", "flush",
+        [](const Arguments&) -> std::string {
+            return "OK\n";
+        });
+
+    server.addCommand("dump", "dump",
+        [](const Arguments&) -> std::string {
+            dumpAllFlightRecorders();
+            return "OK\n";
+        });
+}
+
+}} //< NAMESPACE-END: simplelog::backend_syslog
@@ -0,0 +1,87 @@
+/**
+ * @file simplelog/backend/syslog/FacilityConfig.hpp
+ * Provides the syslog facility per module (or module prefix).
+ *
+ * @code
+ *  simplelog::backend_syslog::setFacility("db.*", LOG_LOCAL1);
+ *  simplelog::backend_syslog::setFacility("audit", LOG_AUTHPRIV);
+ * @endcode
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include "simplelog/backend/common/LevelConfig.hpp"  //< USE: matchesModulePattern()
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND: FACILITY CONFIG
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_syslog {
+
+struct FacilityConfigEntry
+{
+    std::string pattern;    //< Module pattern (as: "db.*")
+    int facility;           //< Syslog facility (as: LOG_LOCAL1)
+};
+
+/**
+ * @class FacilityConfig
+ * Facility rules for modules (the last matching rule is used).
+ * @note A facility of 0 means: Use the default facility (from openlog()).
+ **/
+class FacilityConfig
+{
+private:
+    mutable std::mutex m_mutex;
+    std::vector<FacilityConfigEntry> m_entries;
+
+public:
+    //! Adds (or replaces) the facility rule for this module pattern.
+    void setFacility(const std::string& pattern, int facility)
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto iter = m_entries.begin(); iter != m_entries.end(); ++iter) {
+            if (iter->pattern == pattern) {
+                m_entries.erase(iter);
+                break;
+            }
+        }
+        m_entries.push_back(FacilityConfigEntry{pattern, facility});
+    }
+
+    //! Returns the facility of this module (or 0: default facility).
+    int findFacility(std::string_view moduleName) const
+    {
+        using simplelog::backend_common::matchesModulePattern;
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto iter = m_entries.rbegin(); iter != m_entries.rend(); ++iter) {
+            if (matchesModulePattern(iter->pattern, moduleName)) {
+                return iter->facility;
+            }
+        }
+        return 0;
+    }
+
+    void clear()
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+    }
+};
+
+//! Provides the FacilityConfig that is used by new modules.
+inline FacilityConfig& getFacilityConfig()
+{
+    static FacilityConfig theConfig;
+    return theConfig;
+}
+
+}} //< NAMESPACE-END: simplelog::backend_syslog
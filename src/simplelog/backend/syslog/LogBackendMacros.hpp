@@ -33,7 +33,13 @@
 // --------------------------------------------------------------------------
 // LOGGING BACKEND MACROS
 // --------------------------------------------------------------------------
-#define SIMPLELOG_BACKEND_DEFINE_MODULE(module, name) auto module = ::simplelog::backend_syslog::useOrCreateModule(name)
+/**
+ * @macro SIMPLELOG_BACKEND_DEFINE_MODULE(module, name)
+ * Defines a logging module (as ModuleHandle).
+ * @note The module name must be a string literal (hash is computed at compile-time).
+ **/
+#define SIMPLELOG_BACKEND_DEFINE_MODULE(module, name) \
+    auto module = ::simplelog::backend_syslog::useOrCreateModule(SIMPLELOG_BACKEND_MODULE_NAME(name))
 #define SIMPLELOG_BACKEND_LOG(module, level, ...) module->log(level, __VA_ARGS__)
 #define SIMPLELOG_BACKEND_LOG0(module, level, message)    module->log(level, message)
 
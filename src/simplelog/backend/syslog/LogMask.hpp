@@ -0,0 +1,98 @@
+/**
+ * @file simplelog/backend/syslog/LogMask.hpp
+ * Mirrors the module levels into the libc syslog log mask (setlogmask()).
+ *
+ * The log mask is cached (as atomic). Therefore, Module::isLevelEnabled()
+ * rejects log-records outside of the log mask before they are formatted
+ * (without the libc syslog lock).
+ *
+ * @code
+ *  simplelog::backend_syslog::enableLogMaskSync();  //< SEE: SetupUtil.hpp
+ * @endcode
+ *
+ * @note The libc log mask is global: Thread level overrides and flight
+ *       recorder dumps above the mask are dropped by syslog().
+ *       Use the SyslogTransport for them (it ignores the libc log mask).
+ * @see https://www.man7.org/linux/man-pages/man3/setlogmask.3.html
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <atomic>
+#include <mutex>
+#include <syslog.h>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND: LOG MASK
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_syslog {
+
+namespace detail {
+
+inline std::atomic<int> cachedLogMask(LOG_UPTO(LOG_DEBUG));
+inline std::atomic<bool> logMaskSyncEnabled(false);
+inline std::atomic<int> savedLogMask(LOG_UPTO(LOG_DEBUG));  //< Of the application (before sync).
+
+inline std::mutex& getLogMaskMutex()
+{
+    static std::mutex theMutex;
+    return theMutex;
+}
+
+} //< NAMESPACE-END: detail
+
+//! Returns the cached log mask (as: LOG_UPTO(LOG_INFO)).
+inline int getLogMask()
+{
+    return detail::cachedLogMask.load(std::memory_order_relaxed);
+}
+
+//! Checks if syslog() would send a log-record with this level (FAST PATH).
+inline bool isLevelInLogMask(int level)
+{
+    return (getLogMask() & LOG_MASK(level & LOG_PRIMASK)) != 0;
+}
+
+//! Sets the libc log mask (and its cached value).
+inline void setLogMask(int mask)
+{
+    if (mask == 0) {
+        return;     //< HINT: setlogmask(0) does not change the log mask.
+    }
+    // -- CRITICAL-SECTION
+    std::lock_guard<std::mutex> lock(detail::getLogMaskMutex());
+    ::setlogmask(mask);
+    detail::cachedLogMask.store(mask, std::memory_order_relaxed);
+}
+
+//! Adds this level (and all more severe ones) to the log mask.
+inline void raiseLogMask(int level)
+{
+    // -- CRITICAL-SECTION
+    std::lock_guard<std::mutex> lock(detail::getLogMaskMutex());
+    const int mask = detail::cachedLogMask.load(std::memory_order_relaxed) | LOG_UPTO(level);
+    ::setlogmask(mask);
+    detail::cachedLogMask.store(mask, std::memory_order_relaxed);
+}
+
+/**
+ * Reads the libc log mask into the cache.
+ * @note Needed if other code calls setlogmask() directly.
+ **/
+inline int refreshLogMask()
+{
+    // -- CRITICAL-SECTION
+    std::lock_guard<std::mutex> lock(detail::getLogMaskMutex());
+    const int mask = ::setlogmask(0);
+    detail::cachedLogMask.store(mask, std::memory_order_relaxed);
+    return mask;
+}
+
+inline bool isLogMaskSyncEnabled()
+{
+    return detail::logMaskSyncEnabled.load(std::memory_order_relaxed);
+}
+
+}} //< NAMESPACE-END: simplelog::backend_syslog
@@ -9,8 +9,19 @@
 
 // -- INCLUDES:
 #include "simplelog/backend/common/ModuleBase.hpp"
+#include "simplelog/backend/common/ThreadLevelOverride.hpp"
+#include "simplelog/backend/common/DiagnosticContext.hpp"
+#include "simplelog/backend/common/FlightRecorder.hpp"
+#include "simplelog/backend/syslog/AsyncSender.hpp"
+#include "simplelog/backend/syslog/FacilityConfig.hpp"
+#include "simplelog/backend/syslog/LogMask.hpp"
+#include "simplelog/backend/syslog/Transport.hpp"
 #include <syslog.h>
 #include <fmt/format.h>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
 
 
 // --------------------------------------------------------------------------
@@ -18,6 +29,60 @@
 // --------------------------------------------------------------------------
 namespace simplelog { namespace backend_syslog {
 
+using FlightRecord = simplelog::backend_common::FlightRecord;
+
+/**
+ * Sends a formatted log-record:
+ * @param level  Syslog level (optional: ORed with the facility, as: LOG_LOCAL1|LOG_INFO).
+ *
+ *
+ *   - ASYNC MODE: Enqueues it for the AsyncSender (if used).
+ *   - OTHERWISE:  With the SyslogTransport (if used) or syslog() function.
+ **/
+inline void sendToSyslog(int level, std::string_view text)
+{
+    if (auto* sender = getAsyncSender()) {
+        sender->enqueue(level, text);
+    } else if (auto* transport = getSyslogTransport()) {
+        transport->send(level, text);
+    } else {
+        // -- HINT: Need format string part and args.
+        // OTHERWISE: Compiler will complain with -Wformat-security.
+        // "%.*s": Copies the bytes (no strlen(), no null-terminator needed).
+        syslog(level, "%.*s", static_cast<int>(text.size()), text.data());
+    }
+}
+
+//! Formats captured log-records (like: Module::log()).
+struct FlightRecordFormatter
+{
+    template<typename FormatT, typename... Args>
+    static void format(std::string& text, const FormatT& format, const Args&... args)
+    {
+        text = fmt::vformat(fmt::string_view(format), fmt::make_format_args(args...));
+    }
+};
+
+//! Sends the flight recorder records of this thread (oldest first).
+inline void dumpFlightRecorder()
+{
+    simplelog::backend_common::dumpFlightRecorder(
+        [](const FlightRecord& record, const std::string& text) {
+            const auto facility = getFacilityConfig().findFacility(record.getName());
+            sendToSyslog(record.level | facility, text);
+        });
+}
+
+//! Sends the flight recorder records of all threads.
+inline void dumpAllFlightRecorders()
+{
+    simplelog::backend_common::dumpAllFlightRecorders(
+        [](const FlightRecord& record, const std::string& text) {
+            const auto facility = getFacilityConfig().findFacility(record.getName());
+            sendToSyslog(record.level | facility, text);
+        });
+}
+
 /**
  * @class Module
  * Provides a named logging module (logger) to log to syslog.
@@ -30,22 +95,41 @@ namespace simplelog { namespace backend_syslog {
 class Module : public simplelog::backend_common::ModuleBase
 {
 public:
-    explicit Module(const std::string& name="")
-        : simplelog::backend_common::ModuleBase(name, LOG_WARNING)
-    {}
-    explicit Module(const std::string& name, int level)
-        : simplelog::backend_common::ModuleBase(name, level)
+    using ModuleId = simplelog::backend_common::ModuleId;
+    using ModuleSlot = simplelog::backend_common::ModuleSlot;
+
+private:
+    std::atomic<int> m_facility;    //< Syslog facility (or 0: default facility).
+
+public:
+    Module(std::string name, ModuleId id, ModuleSlot slot)
+        : simplelog::backend_common::ModuleBase(std::move(name), id, slot),
+          m_facility(getFacilityConfig().findFacility(getName()))
     {}
 
+    int getFacility() const { return m_facility.load(std::memory_order_relaxed); }
+    void setFacility(int facility) { m_facility.store(facility, std::memory_order_relaxed); }
+
     inline bool isLevelEnabled(int level) const
     {
         // LOG_EMERG=0, ..., LOG_DEBUG=7
-        return (level <= getLevel());
+        // -- LOG MASK: Rejects records that syslog() would drop (before formatting).
+        return ((level <= getLevel()) && isLevelInLogMask(level)) ||
+               isLevelEnabledForThisThread(level);
+    }
+
+    //! Checks the level overrides of the current thread (SLOW PATH).
+    bool isLevelEnabledForThisThread(int level) const
+    {
+        int overrideLevel = 0;
+        return simplelog::backend_common::hasThreadLevelOverrides() &&
+               simplelog::backend_common::findThreadLevelOverride(getName(), overrideLevel) &&
+               (level <= overrideLevel);
     }
 
     void setMinLevel(int minLevel)
     {
-        if (isLevelEnabled(minLevel)) {
+        if (minLevel <= getLevel()) {
             // -- INCREASE-LEVEL: To MIN-LEVEL (from SAME-LEVEL or LOWER-LEVEL).
             setLevel(minLevel);
         }
@@ -55,12 +139,47 @@ public:
     void log(int level, const Args& ... args)
     {
         if (isLevelEnabled(level)) {
-            // -- HINT: Need format string part and args.
-            // OTHERWISE: Compiler will complain with -Wformat-security.
-            std::string text = fmt::format(args...);
-            syslog(level, "%s", text.c_str());
+            if (!isWithinBudget()) {
+                return;     //< OVER BUDGET: Before formatting and sending.
+            }
+            if ((level <= LOG_ERR) && simplelog::backend_common::hasFlightRecords()) {
+                dumpFlightRecorder();
+            }
+            // -- SINGLE FORMAT PASS: Into the inline (stack) storage of the buffer.
+            // No heap allocation (unless the record is larger than the buffer).
+            // -- DIAGNOSTIC-CONTEXT: Cached prefix (or empty string).
+            const auto& prefix = simplelog::backend_common::getDiagnosticContextPrefix();
+            fmt::memory_buffer buffer;
+            buffer.append(prefix.data(), prefix.data() + prefix.size());
+            fmt::format_to(std::back_inserter(buffer), args...);
+            sendToSyslog(level | getFacility(), std::string_view(buffer.data(), buffer.size()));
+            countRecord();
+        } else if (simplelog::backend_common::isFlightRecorderEnabled()) {
+            simplelog::backend_common::recordInFlightRecorder<FlightRecordFormatter>(
+                getName(), level, args...);
+        }
+    }
+
+protected:
+    /**
+     * LOG MASK SYNC: A more verbose level is added to the log mask now.
+     * A less verbose level is removed from it with the next syncLogMask().
+     * @note Used for each level change (as: ModuleBase::setLevel()).
+     **/
+    void onLevelChanged(int level) override
+    {
+        if (isLogMaskSyncEnabled() && !isLevelInLogMask(level)) {
+            raiseLogMask(level);
         }
     }
+
+    void sendBudgetSummary(std::uint64_t droppedCount) override
+    {
+        fmt::memory_buffer buffer;
+        fmt::format_to(std::back_inserter(buffer),
+            "{} log-records dropped by simplelog budget (module: {})", droppedCount, getName());
+        sendToSyslog(LOG_WARNING | getFacility(), std::string_view(buffer.data(), buffer.size()));
+    }
 };
 
 }} //< NAMESPACE-END: simplelog::backend_syslog
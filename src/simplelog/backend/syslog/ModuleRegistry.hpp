@@ -13,7 +13,6 @@
 // -- INCLUDES:
 #include "simplelog/backend/syslog/Module.hpp"
 #include "simplelog/backend/common/ModuleRegistry.hpp"
-#include <memory>
 
 
 // --------------------------------------------------------------------------
@@ -21,8 +20,9 @@
 // --------------------------------------------------------------------------
 namespace simplelog { namespace backend_syslog {
 
-using ModulePtr = std::shared_ptr<simplelog::backend_syslog::Module>;
 using ModuleRegistry = simplelog::backend_common::ModuleRegistry<Module>;
+using ModulePtr = ModuleRegistry::ModulePtr;   //< ModuleHandle (no refcount)
+using ModuleId = simplelog::backend_common::ModuleId;
 
 // -- FORWARD-DECLARATION:
 ModuleRegistry& getModuleRegistry();
@@ -34,7 +34,14 @@ ModuleRegistry& getModuleRegistry()
 }
 #endif
 
-inline ModulePtr useOrCreateModule(const std::string& name)
+using ModuleName = simplelog::backend_common::ModuleName;
+
+/**
+ * Use existing module or create a new one with this name.
+ * @param name  Module name (hash of a string literal is computed at compile-time).
+ * @return ModuleHandle to the module (owned by the ModuleRegistry).
+ **/
+inline ModulePtr useOrCreateModule(const ModuleName& name)
 {
     return getModuleRegistry().useOrCreateModule(name);
 }
@@ -0,0 +1,263 @@
+/**
+ * @file simplelog/backend/syslog/SetupUtil.hpp
+ * Simplelog backend for syslog: Utility functions to setup the modules.
+ *
+ * @see https://linux.die.net/man/3/syslog
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include "simplelog/backend/syslog/ModuleRegistry.hpp"
+#include "simplelog/backend/syslog/AsyncSender.hpp"
+#include "simplelog/backend/syslog/FacilityConfig.hpp"
+#include "simplelog/backend/syslog/LogMask.hpp"
+#include "simplelog/backend/common/LevelConfig.hpp"
+#include <syslog.h>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND SETUP UTILITIES
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_syslog {
+
+using LevelConfig = simplelog::backend_common::LevelConfig;
+
+/**
+ * Converts a level name into a syslog level (as: "debug", "warn", "err").
+ * @return true, if the level name is known. Otherwise, false.
+ **/
+inline bool parseLevel(std::string_view name, int& level)
+{
+    using simplelog::backend_common::LevelSeverity;
+    static constexpr int levels[] = {
+        LOG_DEBUG,      //< Trace
+        LOG_DEBUG,      //< Debug
+        LOG_INFO,       //< Info
+        LOG_NOTICE,     //< Notice
+        LOG_WARNING,    //< Warning
+        LOG_ERR,        //< Error
+        LOG_CRIT,       //< Critical
+        LOG_ALERT,      //< Alert
+        LOG_EMERG,      //< Emergency
+        LOG_EMERG       //< Off
+    };
+    LevelSeverity severity;
+    if (!simplelog::backend_common::parseLevelSeverity(name, severity)) {
+        return false;
+    }
+    level = levels[static_cast<int>(severity)];
+    return true;
+}
+
+/**
+ * Mirrors the most verbose level (of all modules and the default level)
+ * into the libc log mask: setlogmask(LOG_UPTO(level)).
+ **/
+inline void syncLogMask(ModuleRegistry& registry)
+{
+    int maxLevel = registry.getDefaultLevel();
+    for (const auto& rule : registry.getLevelRules()) {
+        maxLevel = std::max(maxLevel, rule.level);  //< For new modules.
+    }
+    registry.applyToModules([&](ModulePtr module) {
+        maxLevel = std::max(maxLevel, module->getLevel());
+    });
+    setLogMask(LOG_UPTO(std::min(maxLevel, LOG_DEBUG)));
+}
+
+inline void syncLogMask()
+{
+    syncLogMask(getModuleRegistry());
+}
+
+/**
+ * Enables (or disables) the log mask synchronisation:
+ * Level changes (with the SetupUtil functions) update the libc log mask.
+ * @note Disabled: The log mask of the application is restored
+ *       (that was used before the sync was enabled).
+ **/
+inline void enableLogMaskSync(ModuleRegistry& registry, bool enabled = true)
+{
+    const bool wasEnabled = detail::logMaskSyncEnabled.exchange(enabled, std::memory_order_relaxed);
+    if (enabled) {
+        if (!wasEnabled) {
+            detail::savedLogMask.store(refreshLogMask(), std::memory_order_relaxed);
+        }
+        syncLogMask(registry);
+    } else if (wasEnabled) {
+        setLogMask(detail::savedLogMask.load(std::memory_order_relaxed));
+    }
+}
+
+inline void enableLogMaskSync(bool enabled = true)
+{
+    enableLogMaskSync(getModuleRegistry(), enabled);
+}
+
+//! Sets the level for new modules (and syncs the log mask).
+inline void setDefaultLevel(ModuleRegistry& registry, int level)
+{
+    registry.setDefaultLevel(level);
+    if (isLogMaskSyncEnabled()) {
+        syncLogMask(registry);
+    }
+}
+
+inline void setDefaultLevel(int level)
+{
+    setDefaultLevel(getModuleRegistry(), level);
+}
+
+namespace detail {
+
+//! Converts a LevelConfig into level rules (entries with unknown level are ignored).
+inline ModuleRegistry::LevelRules makeLevelRules(const LevelConfig& config)
+{
+    ModuleRegistry::LevelRules rules;
+    for (const auto& entry : config) {
+        int level;
+        if (parseLevel(entry.level, level)) {
+            rules.push_back(ModuleRegistry::LevelRule{ entry.pattern, level });
+        }
+    }
+    return rules;
+}
+
+//! Assigns the level of the last matching rule to each existing module.
+inline void applyLevelRules(ModuleRegistry& registry, const ModuleRegistry::LevelRules& rules)
+{
+    using simplelog::backend_common::matchesModulePattern;
+    registry.applyToModules([&](ModulePtr module) {
+        int newLevel = module->getLevel();
+        for (const auto& rule : rules) {
+            if (matchesModulePattern(rule.pattern, module->getName())) {
+                newLevel = rule.level;
+            }
+        }
+        if (newLevel != module->getLevel()) {
+            module->setLevel(newLevel);
+        }
+    });
+    if (isLogMaskSyncEnabled()) {
+        syncLogMask(registry);
+    }
+}
+
+} //< NAMESPACE-END: detail
+
+/**
+ * Applies a LevelConfig to all existing modules of a ModuleRegistry
+ * and to the modules that are created later (replaces the previous config).
+ * Entries with unknown level name are ignored (sink names are not supported).
+ * @note Log-users are not blocked: The module level is an atomic.
+ **/
+inline void applyLevelConfig(ModuleRegistry& registry, const LevelConfig& config)
+{
+    auto rules = detail::makeLevelRules(config);
+    registry.setLevelRules(rules);
+    detail::applyLevelRules(registry, rules);
+}
+
+inline void applyLevelConfig(const LevelConfig& config)
+{
+    applyLevelConfig(getModuleRegistry(), config);
+}
+
+/**
+ * Adds a LevelConfig to the applied config (as: one changed entry).
+ * Is applied to all existing modules and to the modules that are created later.
+ **/
+inline void addLevelConfig(ModuleRegistry& registry, const LevelConfig& config)
+{
+    const auto rules = detail::makeLevelRules(config);
+    registry.addLevelRules(rules);
+    detail::applyLevelRules(registry, rules);
+}
+
+inline void addLevelConfig(const LevelConfig& config)
+{
+    addLevelConfig(getModuleRegistry(), config);
+}
+
+/**
+ * Opens the connection to the syslog daemon (for the syslog() function).
+ *
+ * @param ident     Prepended to each log-record (as: program name).
+ * @param options   openlog() options (as: LOG_PID, LOG_NDELAY, LOG_CONS).
+ * @param facility  Default facility (for modules without own facility).
+ * @note LOG_NDELAY: Connects now (not on the first log-record).
+ * @note The SyslogTransport uses its own appName and facility (constructor).
+ **/
+inline void openSyslog(std::string ident,
+                       int options = LOG_PID | LOG_NDELAY,
+                       int facility = LOG_USER)
+{
+    // -- HINT: openlog() keeps the ident pointer (storage must stay alive).
+    static std::mutex theMutex;
+    static std::string theIdent;
+    // -- CRITICAL-SECTION
+    std::lock_guard<std::mutex> lock(theMutex);
+    closelog();
+    theIdent = std::move(ident);
+    openlog(theIdent.empty() ? nullptr : theIdent.c_str(), options, facility);
+}
+
+inline void closeSyslog()
+{
+    closelog();
+}
+
+/**
+ * Sets the syslog facility for modules (as: "db.*", LOG_LOCAL1).
+ * Applies to existing modules and to modules that are created later.
+ * @param facility  Syslog facility (or 0: Use the default facility).
+ **/
+inline void setFacility(ModuleRegistry& registry, const std::string& pattern, int facility)
+{
+    using simplelog::backend_common::matchesModulePattern;
+    getFacilityConfig().setFacility(pattern, facility);
+    registry.applyToModules([&](ModulePtr module) {
+        if (matchesModulePattern(pattern, module->getName())) {
+            module->setFacility(facility);
+        }
+    });
+}
+
+inline void setFacility(const std::string& pattern, int facility)
+{
+    setFacility(getModuleRegistry(), pattern, facility);
+}
+
+/**
+ * Enables the async mode for all modules:
+ * Module::log() only enqueues the formatted log-record and
+ * a sender thread sends the log-records (in batches).
+ *
+ * @param queueSize  Max. number of queued log-records.
+ * @param policy     What to do if the queue is full.
+ * @param transport  Transport to use (or nullptr: use the current one or syslog()).
+ * @return AsyncSender (provides the counters: dropped, sent).
+ **/
+inline AsyncSenderPtr setupAsync(std::size_t queueSize = AsyncSender::DEFAULT_QUEUE_SIZE,
+                                 AsyncOverflowPolicy policy = AsyncOverflowPolicy::Block,
+                                 SyslogTransportPtr transport = SyslogTransportPtr())
+{
+    auto sender = std::make_shared<AsyncSender>(queueSize, policy, std::move(transport));
+    useAsyncSender(sender);
+    return sender;
+}
+
+//! Disables the async mode (after the queued log-records are sent).
+inline void shutdownAsync()
+{
+    useAsyncSender(AsyncSenderPtr());
+}
+
+}} //< NAMESPACE-END: simplelog::backend_syslog
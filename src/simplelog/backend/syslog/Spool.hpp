@@ -0,0 +1,256 @@
+/**
+ * @file simplelog/backend/syslog/Spool.hpp
+ * Provides a disk spool for encoded syslog records (while disconnected).
+ *
+ * The spool file contains octet-counted frames (RFC 6587 / RFC 5425):
+ * "LEN SP MSG" (as: "11 Hello Alice"). Records from a previous run of the
+ * program are kept and replayed after the next successful reconnect.
+ *
+ * @see https://www.rfc-editor.org/rfc/rfc5425#section-4.3
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND: SYSLOG SPOOL
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_syslog {
+
+namespace detail {
+
+/**
+ * Writes the octet-count prefix "LEN " of a frame into the buffer.
+ * @return Size of the prefix.
+ **/
+inline std::size_t formatOctetCount(char (&buffer)[24], std::size_t size)
+{
+    const int length = std::snprintf(buffer, sizeof(buffer), "%zu ", size);
+    return (length > 0) ? static_cast<std::size_t>(length) : 0;
+}
+
+/**
+ * Parses the next octet-counted frame of the data.
+ * @return true, if a complete frame was parsed. Otherwise, false.
+ **/
+inline bool parseOctetCountedFrame(std::string_view& data, std::string_view& frame)
+{
+    std::size_t size = 0;
+    std::size_t pos = 0;
+    while ((pos < data.size()) && (data[pos] >= '0') && (data[pos] <= '9')) {
+        size = (size * 10) + static_cast<std::size_t>(data[pos] - '0');
+        ++pos;
+    }
+    if ((pos == 0) || (pos >= data.size()) || (data[pos] != ' ') ||
+        (data.size() - pos - 1 < size)) {
+        return false;
+    }
+    frame = data.substr(pos + 1, size);
+    data.remove_prefix(pos + 1 + size);
+    return true;
+}
+
+//! Writes all parts (handles short writes).
+inline bool writeAll(int fd, iovec* parts, int count)
+{
+    while (count > 0) {
+        const auto written = ::writev(fd, parts, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        auto remaining = static_cast<std::size_t>(written);
+        while ((count > 0) && (remaining >= parts->iov_len)) {
+            remaining -= parts->iov_len;
+            ++parts;
+            --count;
+        }
+        if (count > 0) {
+            parts->iov_base = static_cast<char*>(parts->iov_base) + remaining;
+            parts->iov_len -= remaining;
+        }
+    }
+    return true;
+}
+
+} //< NAMESPACE-END: detail
+
+/**
+ * @class SyslogSpool
+ * Append-only file of encoded log-records (octet-counted frames).
+ * @note Not thread-safe: The SyslogTransport serializes the access.
+ **/
+class SyslogSpool
+{
+public:
+    static constexpr std::size_t DEFAULT_MAX_SIZE = 64 * 1024 * 1024;
+
+private:
+    std::string m_path;
+    std::size_t m_maxSize;  //< In bytes.
+    std::size_t m_size;     //< In bytes.
+    std::size_t m_count;    //< Number of records.
+    int m_fd;
+
+public:
+    explicit SyslogSpool(std::string path, std::size_t maxSize = DEFAULT_MAX_SIZE)
+        : m_path(std::move(path)), m_maxSize(maxSize), m_size(0), m_count(0), m_fd(-1)
+    {
+        open();
+        std::string data;
+        if (readAll(data)) {
+            // -- RECORDS OF PREVIOUS RUN: Count them (and cut off a torn last frame).
+            std::string_view rest(data);
+            std::string_view frame;
+            while (detail::parseOctetCountedFrame(rest, frame)) {
+                ++m_count;
+            }
+            m_size = data.size() - rest.size();
+            if (!rest.empty() && (::ftruncate(m_fd, static_cast<off_t>(m_size)) != 0)) {
+                // -- IGNORE
+            }
+        }
+    }
+
+    ~SyslogSpool()
+    {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+
+    SyslogSpool(const SyslogSpool&) = delete;
+    SyslogSpool& operator=(const SyslogSpool&) = delete;
+
+    const std::string& getPath() const { return m_path; }
+    bool isOpen() const { return m_fd >= 0; }
+    bool empty() const { return m_count == 0; }
+    std::size_t size() const { return m_count; }
+    std::size_t getSizeInBytes() const { return m_size; }
+
+    /**
+     * Appends one encoded log-record.
+     * @return true, if appended. Otherwise, false (spool is full or not writable).
+     **/
+    bool append(std::string_view record)
+    {
+        char prefix[24];
+        const auto prefixSize = detail::formatOctetCount(prefix, record.size());
+        if ((m_fd < 0) || (m_size + prefixSize + record.size() > m_maxSize)) {
+            return false;
+        }
+        iovec parts[2] = {
+            {prefix, prefixSize},
+            {const_cast<char*>(record.data()), record.size()}
+        };
+        if (!detail::writeAll(m_fd, parts, 2)) {
+            return false;
+        }
+        m_size += prefixSize + record.size();
+        ++m_count;
+        return true;
+    }
+
+    /**
+     * Sends the spooled log-records (oldest first) with the send function.
+     * Stops at the first failed record (it and the later records are kept).
+     * @return true, if the spool is empty (now). Otherwise, false.
+     **/
+    template<typename SendFunc>
+    bool replay(SendFunc send)
+    {
+        std::string data;
+        if (empty() || !readAll(data)) {
+            return empty();
+        }
+        const auto count = m_count;
+        std::string_view rest(data);
+        std::string_view frame;
+        for (;;) {
+            const auto frameOffset = data.size() - rest.size();
+            if (!detail::parseOctetCountedFrame(rest, frame)) {
+                break;
+            }
+            if (!send(frame)) {
+                // -- KEEP: This record and the later ones.
+                if (!keepTail(data, frameOffset)) {
+                    m_count = count;    //< KEPT ALL: Sent records are replayed again.
+                }
+                return false;
+            }
+            --m_count;
+        }
+        truncate();
+        return true;
+    }
+
+private:
+    void open()
+    {
+        m_fd = ::open(m_path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    }
+
+    bool readAll(std::string& data) const
+    {
+        struct stat info{};
+        if ((m_fd < 0) || (::fstat(m_fd, &info) != 0)) {
+            return false;
+        }
+        data.resize(static_cast<std::size_t>(info.st_size));
+        std::size_t offset = 0;
+        while (offset < data.size()) {
+            const auto count = ::pread(m_fd, &data[offset], data.size() - offset,
+                                       static_cast<off_t>(offset));
+            if (count <= 0) {
+                break;
+            }
+            offset += static_cast<std::size_t>(count);
+        }
+        data.resize(offset);
+        return true;
+    }
+
+    void truncate()
+    {
+        if (::ftruncate(m_fd, 0) == 0) {
+            m_size = 0;
+            m_count = 0;
+        }
+    }
+
+    //! Replaces the spool file with its tail (atomically: with rename).
+    bool keepTail(const std::string& data, std::size_t offset)
+    {
+        const std::string tmpPath = m_path + ".tmp";
+        const int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            return false;
+        }
+        iovec parts[1] = {{const_cast<char*>(data.data() + offset), data.size() - offset}};
+        const bool written = detail::writeAll(fd, parts, 1);
+        ::close(fd);
+        if (!written || (::rename(tmpPath.c_str(), m_path.c_str()) != 0)) {
+            ::unlink(tmpPath.c_str());
+            return false;
+        }
+        ::close(m_fd);
+        open();
+        m_size = data.size() - offset;
+        return true;
+    }
+};
+
+}} //< NAMESPACE-END: simplelog::backend_syslog
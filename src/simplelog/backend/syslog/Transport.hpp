@@ -0,0 +1,921 @@
+/**
+ * @file simplelog/backend/syslog/Transport.hpp
+ * Provides a native syslog transport (without the libc syslog() function).
+ *
+ * The SyslogTransport sends RFC 3164 or RFC 5424 encoded log-records
+ * over its own socket to a syslog daemon or relay:
+ *
+ *   - "/dev/log":         AF_UNIX datagram socket (default).
+ *   - "udp://host:port":  One datagram per log-record (RFC 5426).
+ *   - "tcp://host:port":  Octet-counted frames "LEN SP MSG" (RFC 5425 framing).
+ *                         Pipelined: A batch is written with one sendmsg() call.
+ *
+ *
+ *   - No global libc syslog lock (datagram send is atomic).
+ *   - The "hostname app[pid]: " part of the header is cached.
+ *     RFC 3164 over AF_UNIX omits the hostname (as: glibc syslog()).
+ *     The local daemon adds it (network: The hostname is sent).
+ *   - The timestamp is rendered only once per second (and thread).
+ *   - Connects eagerly and reconnects once if the syslog daemon restarted.
+ *   - Buffers log-records while the socket is gone (as: journald restart)
+ *     and replays them (in order) after the next successful reconnect.
+ *     Reconnects are rate-limited (no reconnect-per-message storm).
+ *   - Network: Connects non-blocking (waits at most the connect-timeout).
+ *     The resolved host addresses are cached: The host is resolved again
+ *     (blocking getaddrinfo()) at most once per resolve-interval.
+ *   - Optional disk spool (instead of the in-memory buffer): setSpoolFile().
+ *   - SyslogBatch: Sends many log-records with one sendmmsg() call.
+ *
+ * @code
+ *  using namespace simplelog::backend_syslog;
+ *  useSyslogTransport(std::make_shared<SyslogTransport>("/dev/log", SyslogFormat::RFC5424));
+ *  SLOG_INFO("Hello Alice");   //< Is sent by the SyslogTransport.
+ * @endcode
+ *
+ * @see https://www.rfc-editor.org/rfc/rfc3164
+ * @see https://www.rfc-editor.org/rfc/rfc5424
+ * @see https://www.rfc-editor.org/rfc/rfc5425
+ * @see https://www.rfc-editor.org/rfc/rfc5426
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include "simplelog/backend/syslog/Spool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fmt/format.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <syslog.h>
+#include <unistd.h>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND: SYSLOG TRANSPORT
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_syslog {
+
+enum class SyslogFormat { RFC3164, RFC5424 };
+enum class SyslogProtocol { Unix, Udp, Tcp };
+
+/**
+ * @struct SyslogAddress
+ * Where the log-records are sent to (as: "/dev/log", "tcp://relay:601").
+ **/
+struct SyslogAddress
+{
+    static constexpr const char* DEFAULT_PORT = "514";
+
+    SyslogProtocol protocol = SyslogProtocol::Unix;
+    std::string path;   //< Protocol::Unix: Socket path.
+    std::string host;   //< Protocol::Udp/Tcp: Host name or IP address (as: "::1").
+    std::string port;   //< Protocol::Udp/Tcp: Port or service name.
+
+    bool isStream() const { return protocol == SyslogProtocol::Tcp; }
+
+    /**
+     * Parses the address: "udp://host:port", "tcp://host:port", "[::1]:port"
+     * or a socket path (as: "/dev/log", "unix:///dev/log").
+     **/
+    static SyslogAddress parse(std::string_view text)
+    {
+        SyslogAddress address;
+        if (text.substr(0, 6) == "udp://") {
+            address.protocol = SyslogProtocol::Udp;
+        } else if (text.substr(0, 6) == "tcp://") {
+            address.protocol = SyslogProtocol::Tcp;
+        } else {
+            if (text.substr(0, 7) == "unix://") {
+                text.remove_prefix(7);
+            }
+            address.path = std::string(text);
+            return address;
+        }
+        text.remove_prefix(6);
+        std::string_view port(DEFAULT_PORT);
+        if (!text.empty() && (text.front() == '[')) {
+            // -- IPV6: "[::1]:514"
+            const auto end = text.find(']');
+            const auto host = text.substr(1, end - 1);
+            if ((end != std::string_view::npos) && (end + 1 < text.size()) && (text[end + 1] == ':')) {
+                port = text.substr(end + 2);
+            }
+            text = host;
+        } else if (const auto colon = text.rfind(':'); colon != std::string_view::npos) {
+            port = text.substr(colon + 1);
+            text = text.substr(0, colon);
+        }
+        address.host = std::string(text);
+        address.port = std::string(port);
+        return address;
+    }
+};
+
+namespace detail {
+
+struct CachedTimestamp
+{
+    std::time_t seconds = -1;
+    char text[32] = {};
+    std::size_t size = 0;
+};
+
+inline std::string getHostName()
+{
+    char name[256] = {};
+    if (::gethostname(name, sizeof(name) - 1) != 0) {
+        return "-";
+    }
+    return name;
+}
+
+inline std::string getProgramName()
+{
+    // -- SAME AS: glibc syslog() default ident.
+    return program_invocation_short_name;
+}
+
+//! Resolved address of the syslog relay (copied from getaddrinfo()).
+struct ResolvedAddress
+{
+    int family;
+    int socketType;
+    int protocol;
+    sockaddr_storage address;
+    socklen_t size;
+};
+
+/**
+ * Connects the socket, but waits at most the timeout (non-blocking connect).
+ * Afterwards, the socket is blocking again.
+ **/
+inline bool connectWithTimeout(int fd, const sockaddr* address, socklen_t size,
+                               std::chrono::milliseconds timeout)
+{
+    const int flags = ::fcntl(fd, F_GETFL, 0);
+    if ((flags < 0) || (::fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0)) {
+        return false;
+    }
+    bool connected = (::connect(fd, address, size) == 0);
+    if (!connected && (errno == EINPROGRESS)) {
+        pollfd pollFd{fd, POLLOUT, 0};
+        int error = ETIMEDOUT;
+        socklen_t errorSize = sizeof(error);
+        if ((::poll(&pollFd, 1, static_cast<int>(timeout.count())) == 1) &&
+            (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &errorSize) != 0)) {
+            error = errno;
+        }
+        connected = (error == 0);
+        errno = error;
+    }
+    return connected && (::fcntl(fd, F_SETFL, flags) == 0);
+}
+
+template<typename T>
+inline void appendText(fmt::memory_buffer& buffer, const T& text)
+{
+    const std::string_view textView(text);
+    buffer.append(textView.data(), textView.data() + textView.size());
+}
+
+} //< NAMESPACE-END: detail
+
+/**
+ * @class SyslogEncoder
+ * Encodes a log-record as RFC 3164 or RFC 5424 syslog message.
+ *
+ *   - RFC3164: "<PRI>Mmm dd hh:mm:ss hostname app[pid]: message"
+ *   - RFC5424: "<PRI>1 YYYY-MM-DDThh:mm:ss.uuuuuuZ hostname app pid - - message"
+ *
+ * An empty hostname is omitted (RFC3164: "<PRI>Mmm dd hh:mm:ss app[pid]: message")
+ * or sent as NILVALUE (RFC5424: "-").
+ **/
+class SyslogEncoder
+{
+public:
+    using Clock = std::chrono::system_clock;
+
+private:
+    SyslogFormat m_format;
+    int m_facility;
+    std::string m_headerSuffix;     //< CACHED: Header part after the timestamp.
+
+public:
+    SyslogEncoder(SyslogFormat format = SyslogFormat::RFC3164,
+                  std::string appName = detail::getProgramName(),
+                  int facility = LOG_USER,
+                  std::string hostName = detail::getHostName())
+        : m_format(format), m_facility(facility), m_headerSuffix()
+    {
+        const auto pid = std::to_string(::getpid());
+        if (m_format == SyslogFormat::RFC5424) {
+            const auto host = hostName.empty() ? std::string("-") : hostName;
+            m_headerSuffix = " " + host + " " + appName + " " + pid + " - - ";
+        } else {
+            const auto host = hostName.empty() ? std::string() : (" " + hostName);
+            m_headerSuffix = host + " " + appName + "[" + pid + "]: ";
+        }
+    }
+
+    SyslogFormat getFormat() const { return m_format; }
+    int getFacility() const { return m_facility; }
+
+    /**
+     * Encodes the log-record into the buffer.
+     * @param level  Syslog level (optional: ORed with the facility, as: LOG_LOCAL1|LOG_INFO).
+     **/
+    void encode(fmt::memory_buffer& buffer, int level, std::string_view message,
+                Clock::time_point time = Clock::now()) const
+    {
+        const auto facility = ((level & LOG_FACMASK) != 0) ? (level & LOG_FACMASK) : m_facility;
+        const auto priority = (facility & LOG_FACMASK) | (level & LOG_PRIMASK);
+        buffer.push_back('<');
+        detail::appendText(buffer, fmt::format_int(priority).c_str());
+        buffer.push_back('>');
+        if (m_format == SyslogFormat::RFC5424) {
+            buffer.push_back('1');
+            buffer.push_back(' ');
+            appendTimestamp5424(buffer, time);
+        } else {
+            appendTimestamp3164(buffer, time);
+        }
+        detail::appendText(buffer, m_headerSuffix);
+        detail::appendText(buffer, message);
+    }
+
+private:
+    /**
+     * Appends "Mmm dd hh:mm:ss" (local time: rendered once per second).
+     * @note The month names are English (as RFC 3164 requires), independent of the locale.
+     **/
+    static void appendTimestamp3164(fmt::memory_buffer& buffer, Clock::time_point time)
+    {
+        static constexpr const char* MONTH_NAMES[12] = {
+            "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+            "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+        };
+        thread_local detail::CachedTimestamp theTimestamp;
+        const auto seconds = Clock::to_time_t(time);
+        if (seconds != theTimestamp.seconds) {
+            std::tm tm;
+            ::localtime_r(&seconds, &tm);
+            const int size = std::snprintf(theTimestamp.text, sizeof(theTimestamp.text),
+                "%s %2d %02d:%02d:%02d", MONTH_NAMES[tm.tm_mon % 12],
+                tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+            theTimestamp.size = (size > 0) ? static_cast<std::size_t>(size) : 0;
+            theTimestamp.seconds = seconds;
+        }
+        buffer.append(theTimestamp.text, theTimestamp.text + theTimestamp.size);
+    }
+
+    //! Appends "YYYY-MM-DDThh:mm:ss.uuuuuuZ" (UTC: rendered once per second).
+    static void appendTimestamp5424(fmt::memory_buffer& buffer, Clock::time_point time)
+    {
+        thread_local detail::CachedTimestamp theTimestamp;
+        const auto seconds = Clock::to_time_t(time);
+        if (seconds != theTimestamp.seconds) {
+            std::tm tm;
+            ::gmtime_r(&seconds, &tm);
+            theTimestamp.size = std::strftime(theTimestamp.text, sizeof(theTimestamp.text),
+                                              "%Y-%m-%dT%H:%M:%S.", &tm);
+            theTimestamp.seconds = seconds;
+        }
+        buffer.append(theTimestamp.text, theTimestamp.text + theTimestamp.size);
+        const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+            time - Clock::from_time_t(seconds)).count();
+        char digits[6];
+        auto value = static_cast<long>(micros);
+        for (int i = 5; i >= 0; --i) {
+            digits[i] = static_cast<char>('0' + (value % 10));
+            value /= 10;
+        }
+        buffer.append(digits, digits + sizeof(digits));
+        buffer.push_back('Z');
+    }
+};
+
+/**
+ * @class SyslogBatch
+ * Collects encoded log-records that are sent with one sendmmsg() call.
+ **/
+class SyslogBatch
+{
+private:
+    fmt::memory_buffer m_buffer;
+    std::vector<std::size_t> m_ends;
+
+public:
+    std::size_t size() const { return m_ends.size(); }
+    bool empty() const { return m_ends.empty(); }
+
+    void add(const SyslogEncoder& encoder, int level, std::string_view message,
+             SyslogEncoder::Clock::time_point time = SyslogEncoder::Clock::now())
+    {
+        encoder.encode(m_buffer, level, message, time);
+        m_ends.push_back(m_buffer.size());
+    }
+
+    std::string_view at(std::size_t index) const
+    {
+        const auto begin = (index == 0) ? 0 : m_ends[index - 1];
+        return std::string_view(m_buffer.data() + begin, m_ends[index] - begin);
+    }
+
+    void clear()
+    {
+        m_buffer.clear();
+        m_ends.clear();
+    }
+};
+
+/**
+ * @class SyslogTransport
+ * Sends encoded log-records to the syslog daemon (or a relay).
+ * @note Thread-safe: A datagram is sent atomically (no lock is needed).
+ *       TCP: Frames are written under a lock (no interleaved frames).
+ *
+ * RECONNECT BUFFERING:
+ * If the socket is gone (and the immediate reconnect fails),
+ * the encoded log-records are kept in a bounded pending queue
+ * (the oldest records are dropped if it is full).
+ * Later log-records are queued, too (keeps the order). Each send attempts
+ * a reconnect at most once per reconnect-interval and replays the queue.
+ * With a spool file, the records are kept on disk instead (and survive
+ * a restart of the program). Replay is at-least-once (TCP: a frame that
+ * was partially written before the connection broke is sent again).
+ **/
+class SyslogTransport
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr const char* DEFAULT_PATH = "/dev/log";
+    static constexpr std::size_t MAX_BATCH_SIZE = 64;
+    static constexpr std::size_t DEFAULT_MAX_PENDING = 1024;
+    static constexpr std::chrono::milliseconds DEFAULT_RECONNECT_INTERVAL{500};
+    static constexpr std::chrono::milliseconds DEFAULT_CONNECT_TIMEOUT{200};
+    static constexpr std::chrono::seconds DEFAULT_RESOLVE_INTERVAL{30};
+
+private:
+    std::string m_path;
+    SyslogAddress m_address;
+    SyslogEncoder m_encoder;
+    std::atomic<int> m_fd;
+    std::mutex m_connectMutex;
+    std::vector<detail::ResolvedAddress> m_resolved;    //< CACHED: Host addresses.
+    Clock::time_point m_nextResolveTime;
+    std::chrono::milliseconds m_connectTimeout;
+    std::mutex m_writeMutex;                //< TCP: Serializes the frames.
+    std::mutex m_pendingMutex;
+    std::deque<std::string> m_pending;      //< Encoded log-records (to replay).
+    std::unique_ptr<SyslogSpool> m_spool;   //< OPTIONAL: Replaces m_pending.
+    std::atomic<bool> m_hasPending;
+    std::size_t m_maxPending;
+    Clock::duration m_reconnectInterval;
+    Clock::time_point m_nextReconnectTime;
+    std::atomic<std::size_t> m_droppedCount;
+
+public:
+    /**
+     * Creates the transport and connects it.
+     * @param path  Socket path or network address (as: "tcp://relay:601").
+     * @see SyslogAddress::parse()
+     **/
+    explicit SyslogTransport(std::string path = DEFAULT_PATH,
+                             SyslogFormat format = SyslogFormat::RFC3164,
+                             std::string appName = detail::getProgramName(),
+                             int facility = LOG_USER)
+        : m_path(std::move(path)),
+          m_address(SyslogAddress::parse(m_path)),
+          m_encoder(format, std::move(appName), facility, selectHostName(m_address, format)),
+          m_fd(-1),
+          m_connectMutex(),
+          m_resolved(),
+          m_nextResolveTime(),
+          m_connectTimeout(DEFAULT_CONNECT_TIMEOUT),
+          m_writeMutex(),
+          m_pendingMutex(),
+          m_pending(),
+          m_spool(),
+          m_hasPending(false),
+          m_maxPending(DEFAULT_MAX_PENDING),
+          m_reconnectInterval(DEFAULT_RECONNECT_INTERVAL),
+          m_nextReconnectTime(),
+          m_droppedCount(0)
+    {
+        reconnect();    //< EAGER: Not on first use.
+    }
+
+    ~SyslogTransport()
+    {
+        const int fd = m_fd.exchange(-1);
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    SyslogTransport(const SyslogTransport&) = delete;
+    SyslogTransport& operator=(const SyslogTransport&) = delete;
+
+    const std::string& getPath() const { return m_path; }
+    const SyslogAddress& getAddress() const { return m_address; }
+    const SyslogEncoder& getEncoder() const { return m_encoder; }
+    bool isConnected() const { return m_fd.load() >= 0; }
+    std::size_t getDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
+    std::size_t getPendingCount()
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        return m_pending.size() + (m_spool ? m_spool->size() : 0);
+    }
+
+    /**
+     * Buffers log-records in this spool file (while disconnected).
+     * Spooled records of a previous run are replayed (after the next reconnect).
+     * @param maxSize  Max. size of the spool file (in bytes).
+     * @return true, if the spool file is usable. Otherwise, false.
+     **/
+    bool setSpoolFile(std::string path, std::size_t maxSize = SyslogSpool::DEFAULT_MAX_SIZE)
+    {
+        auto spool = std::make_unique<SyslogSpool>(std::move(path), maxSize);
+        if (!spool->isOpen()) {
+            return false;
+        }
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        for (const auto& data : m_pending) {
+            if (!spool->append(data)) {
+                m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        m_pending.clear();
+        m_spool = std::move(spool);
+        m_hasPending.store(!m_spool->empty(), std::memory_order_release);
+        return true;
+    }
+
+    //! Sets the max. number of buffered log-records (while disconnected).
+    void setMaxPending(std::size_t maxPending)
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_maxPending = maxPending;
+        dropPendingIfFull(0);
+    }
+
+    //! Sets the min. time between reconnect attempts (while disconnected).
+    void setReconnectInterval(Clock::duration interval)
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_reconnectInterval = interval;
+    }
+
+    //! Sets the max. time that a network connect may wait (on the logging thread).
+    void setConnectTimeout(std::chrono::milliseconds timeout)
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_connectMutex);
+        m_connectTimeout = timeout;
+    }
+
+    /**
+     * (Re)connects the socket to the syslog daemon.
+     * @note The file descriptor number is kept (with dup2()).
+     *       Therefore, concurrent senders never use a closed descriptor.
+     *       TCP: The descriptor is replaced between frames (never within a frame).
+     **/
+    bool reconnect()
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_connectMutex);
+        const int newFd = (m_address.protocol == SyslogProtocol::Unix) ?
+            connectUnixSocket() : connectNetworkSocket();
+        if (newFd < 0) {
+            return false;
+        }
+        std::unique_lock<std::mutex> writeLock(m_writeMutex, std::defer_lock);
+        if (m_address.isStream()) {
+            writeLock.lock();   //< WAIT FOR: Frame that is written now.
+        }
+        const int fd = m_fd.load();
+        if (fd < 0) {
+            m_fd.store(newFd);
+        } else {
+            ::dup2(newFd, fd);
+            ::close(newFd);
+        }
+        return true;
+    }
+
+    //! Encodes and sends one log-record.
+    bool send(int level, std::string_view message,
+              SyslogEncoder::Clock::time_point time = SyslogEncoder::Clock::now())
+    {
+        fmt::memory_buffer buffer;
+        m_encoder.encode(buffer, level, message, time);
+        return sendEncoded(std::string_view(buffer.data(), buffer.size()));
+    }
+
+    /**
+     * Sends one already encoded log-record (reconnects once on failure).
+     * @return true, if sent (or buffered for replay). Otherwise, false.
+     **/
+    bool sendEncoded(std::string_view data)
+    {
+        if (m_hasPending.load(std::memory_order_acquire)) {
+            return addPending(&data, 1);    //< KEEP ORDER: Behind the pending records.
+        }
+        for (int retry = 0; retry < 2; ++retry) {
+            const int fd = m_fd.load();
+            if ((fd >= 0) && sendRecord(fd, data)) {
+                return true;
+            }
+            if (!shouldReconnect(fd)) {
+                return false;
+            }
+            if (!reconnect()) {
+                break;
+            }
+        }
+        return addPending(&data, 1);
+    }
+
+    /**
+     * Reconnects now (if needed) and replays the buffered log-records.
+     * @return true, if no log-records are pending (anymore).
+     **/
+    bool flushPending()
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_nextReconnectTime = Clock::time_point();
+        return replayPending();
+    }
+
+    /**
+     * Sends all log-records of the batch (with sendmmsg(), TCP: sendmsg()).
+     * @return Number of sent log-records.
+     **/
+    std::size_t send(const SyslogBatch& batch)
+    {
+        std::size_t sent = 0;
+        int retries = 0;
+        if (m_hasPending.load(std::memory_order_acquire)) {
+            addPendingBatch(batch, 0);
+            return 0;
+        }
+        while (sent < batch.size()) {
+            const auto count = std::min(batch.size() - sent, MAX_BATCH_SIZE);
+            const int fd = m_fd.load();
+            const int result = (fd < 0) ? -1 : m_address.isStream() ?
+                sendFrames(fd, batch, sent, count) : sendDatagrams(fd, batch, sent, count);
+            if (result > 0) {
+                sent += static_cast<std::size_t>(result);
+                continue;
+            }
+            if (!shouldReconnect(fd)) {
+                break;
+            }
+            if ((++retries > 1) || !reconnect()) {
+                addPendingBatch(batch, sent);
+                break;
+            }
+        }
+        return sent;
+    }
+
+private:
+    //! RFC3164 over AF_UNIX: No hostname (the local daemon adds it).
+    static std::string selectHostName(const SyslogAddress& address, SyslogFormat format)
+    {
+        const bool isLocal3164 = (address.protocol == SyslogProtocol::Unix) &&
+                                 (format == SyslogFormat::RFC3164);
+        return isLocal3164 ? std::string() : detail::getHostName();
+    }
+
+    int connectUnixSocket() const
+    {
+        const int fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, m_address.path.c_str(), sizeof(address.sun_path) - 1);
+        if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    /**
+     * Connects to the first usable (cached) address of the host.
+     * Resolves the host again if none is usable (at most once per resolve-interval).
+     * @pre m_connectMutex is locked.
+     **/
+    int connectNetworkSocket()
+    {
+        int fd = connectResolvedSocket();
+        if ((fd < 0) && (Clock::now() >= m_nextResolveTime)) {
+            m_nextResolveTime = Clock::now() + DEFAULT_RESOLVE_INTERVAL;
+            if (resolve()) {
+                fd = connectResolvedSocket();
+            }
+        }
+        return fd;
+    }
+
+    //! @pre m_connectMutex is locked.
+    int connectResolvedSocket() const
+    {
+        for (const auto& address : m_resolved) {
+            const int fd = ::socket(address.family, address.socketType | SOCK_CLOEXEC, address.protocol);
+            if (fd < 0) {
+                continue;
+            }
+            if (detail::connectWithTimeout(fd, reinterpret_cast<const sockaddr*>(&address.address),
+                                           address.size, m_connectTimeout)) {
+                return fd;
+            }
+            ::close(fd);
+        }
+        return -1;
+    }
+
+    //! Resolves the host (blocking) and caches its addresses.
+    //! @pre m_connectMutex is locked.
+    bool resolve()
+    {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = m_address.isStream() ? SOCK_STREAM : SOCK_DGRAM;
+        addrinfo* addresses = nullptr;
+        if (::getaddrinfo(m_address.host.c_str(), m_address.port.c_str(), &hints, &addresses) != 0) {
+            errno = ENOENT;
+            return false;
+        }
+        m_resolved.clear();
+        for (auto* address = addresses; address; address = address->ai_next) {
+            detail::ResolvedAddress resolved{address->ai_family, address->ai_socktype,
+                                             address->ai_protocol, sockaddr_storage{}, address->ai_addrlen};
+            std::memcpy(&resolved.address, address->ai_addr, address->ai_addrlen);
+            m_resolved.push_back(resolved);
+        }
+        ::freeaddrinfo(addresses);
+        return !m_resolved.empty();
+    }
+
+    //! Sends one encoded log-record (TCP: as octet-counted frame).
+    bool sendRecord(int fd, std::string_view data)
+    {
+        if (!m_address.isStream()) {
+            return ::send(fd, data.data(), data.size(), MSG_NOSIGNAL) >= 0;
+        }
+        char prefix[24];
+        iovec parts[2] = {
+            {prefix, detail::formatOctetCount(prefix, data.size())},
+            {const_cast<char*>(data.data()), data.size()}
+        };
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        return sendAll(fd, parts, 2);
+    }
+
+    int sendDatagrams(int fd, const SyslogBatch& batch, std::size_t first, std::size_t count)
+    {
+        iovec parts[MAX_BATCH_SIZE];
+        mmsghdr messages[MAX_BATCH_SIZE];
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto data = batch.at(first + i);
+            parts[i].iov_base = const_cast<char*>(data.data());
+            parts[i].iov_len = data.size();
+            messages[i] = mmsghdr{};
+            messages[i].msg_hdr.msg_iov = &parts[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        return ::sendmmsg(fd, messages, static_cast<unsigned int>(count), MSG_NOSIGNAL);
+    }
+
+    //! Writes the log-records as octet-counted frames (pipelined: one sendmsg() call).
+    int sendFrames(int fd, const SyslogBatch& batch, std::size_t first, std::size_t count)
+    {
+        char prefixes[MAX_BATCH_SIZE][24];
+        iovec parts[2 * MAX_BATCH_SIZE];
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto data = batch.at(first + i);
+            parts[2 * i].iov_base = prefixes[i];
+            parts[2 * i].iov_len = detail::formatOctetCount(prefixes[i], data.size());
+            parts[2 * i + 1].iov_base = const_cast<char*>(data.data());
+            parts[2 * i + 1].iov_len = data.size();
+        }
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        return sendAll(fd, parts, static_cast<int>(2 * count)) ? static_cast<int>(count) : -1;
+    }
+
+    //! Sends all parts to the stream socket (handles short writes).
+    static bool sendAll(int fd, iovec* parts, int count)
+    {
+        while (count > 0) {
+            msghdr message{};
+            message.msg_iov = parts;
+            message.msg_iovlen = static_cast<std::size_t>(count);
+            const auto written = ::sendmsg(fd, &message, MSG_NOSIGNAL);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            auto remaining = static_cast<std::size_t>(written);
+            while ((count > 0) && (remaining >= parts->iov_len)) {
+                remaining -= parts->iov_len;
+                ++parts;
+                --count;
+            }
+            if (count > 0) {
+                parts->iov_base = static_cast<char*>(parts->iov_base) + remaining;
+                parts->iov_len -= remaining;
+            }
+        }
+        return true;
+    }
+
+    void addPendingBatch(const SyslogBatch& batch, std::size_t first)
+    {
+        std::vector<std::string_view> records;
+        records.reserve(batch.size() - first);
+        for (std::size_t i = first; i < batch.size(); ++i) {
+            records.push_back(batch.at(i));
+        }
+        addPending(records.data(), records.size());
+    }
+
+    //! Buffers the log-records and replays them (if a reconnect is due).
+    bool addPending(const std::string_view* records, std::size_t count)
+    {
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        if (m_spool) {
+            bool spooled = true;
+            for (std::size_t i = 0; i < count; ++i) {
+                if (!m_spool->append(records[i])) {
+                    m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                    spooled = false;
+                }
+            }
+            m_hasPending.store(!m_spool->empty(), std::memory_order_release);
+            if (Clock::now() >= m_nextReconnectTime) {
+                replayPending();
+            }
+            return spooled;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            dropPendingIfFull(1);
+            if (m_maxPending > 0) {
+                m_pending.emplace_back(records[i]);
+            }
+        }
+        m_hasPending.store(!m_pending.empty(), std::memory_order_release);
+        if (Clock::now() >= m_nextReconnectTime) {
+            if (replayPending()) {
+                return true;
+            }
+        }
+        return (m_maxPending > 0);
+    }
+
+    //! Drops the oldest pending log-records (to make room for more records).
+    void dropPendingIfFull(std::size_t room)
+    {
+        while (!m_pending.empty() && (m_pending.size() + room > m_maxPending)) {
+            m_pending.pop_front();
+            m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (m_maxPending < room) {
+            m_droppedCount.fetch_add(room, std::memory_order_relaxed);
+        }
+    }
+
+    //! Reconnects and sends the pending log-records (oldest first).
+    //! @pre m_pendingMutex is locked.
+    bool replayPending()
+    {
+        if (m_spool) {
+            if (!m_spool->empty() && reconnect()) {
+                const int fd = m_fd.load();
+                m_spool->replay([this, fd](std::string_view data) { return sendRecord(fd, data); });
+            }
+            m_hasPending.store(!m_spool->empty(), std::memory_order_release);
+            if (!m_spool->empty()) {
+                m_nextReconnectTime = Clock::now() + m_reconnectInterval;
+            }
+            return m_spool->empty();
+        }
+        if (m_pending.empty()) {
+            return true;
+        }
+        if (reconnect()) {
+            const int fd = m_fd.load();
+            while (!m_pending.empty()) {
+                if (!sendRecord(fd, m_pending.front())) {
+                    break;
+                }
+                m_pending.pop_front();
+            }
+        }
+        m_hasPending.store(!m_pending.empty(), std::memory_order_release);
+        if (!m_pending.empty()) {
+            m_nextReconnectTime = Clock::now() + m_reconnectInterval;
+        }
+        return m_pending.empty();
+    }
+
+    static bool shouldReconnect(int fd)
+    {
+        // -- SYSLOG DAEMON RESTARTED: Socket is no longer connected.
+        return (fd < 0) || (errno == ECONNREFUSED) || (errno == ENOTCONN) ||
+               (errno == ENOENT) || (errno == EBADF) ||
+               (errno == EPIPE) || (errno == ECONNRESET) || (errno == ECONNABORTED);
+    }
+};
+
+using SyslogTransportPtr = std::shared_ptr<SyslogTransport>;
+
+namespace detail {
+
+inline std::atomic<SyslogTransport*> currentSyslogTransport(nullptr);
+
+/**
+ * @struct SyslogTransportHolder
+ * Keeps all used transports alive (modules use the raw pointer).
+ * @note NEVER DESTROYED: Log-records may be sent during static destruction
+ *       (as: by the AsyncSender or by the destructor of a static object).
+ **/
+struct SyslogTransportHolder
+{
+    std::mutex mutex;
+    std::vector<SyslogTransportPtr> pinned;
+    SyslogTransportPtr current;
+};
+
+inline SyslogTransportHolder& getSyslogTransportHolder()
+{
+    static auto* theHolder = new SyslogTransportHolder();   //< NEVER DESTROYED.
+    return *theHolder;
+}
+
+} //< NAMESPACE-END: detail
+
+/**
+ * Uses this transport for all modules (instead of the libc syslog() function).
+ * @param transport  Transport to use (or nullptr: Use syslog() again).
+ * @note A replaced transport is kept alive (until the program ends).
+ **/
+inline void useSyslogTransport(SyslogTransportPtr transport)
+{
+    auto& holder = detail::getSyslogTransportHolder();
+    // -- CRITICAL-SECTION
+    std::lock_guard<std::mutex> lock(holder.mutex);
+    if (transport) {
+        holder.pinned.push_back(transport);
+    }
+    detail::currentSyslogTransport.store(transport.get(), std::memory_order_release);
+    holder.current = std::move(transport);
+}
+
+//! Returns the used transport (or nullptr if syslog() is used).
+inline SyslogTransport* getSyslogTransport()
+{
+    return detail::currentSyslogTransport.load(std::memory_order_acquire);
+}
+
+//! Returns the used transport as shared owner (or nullptr if syslog() is used).
+inline SyslogTransportPtr getSyslogTransportPtr()
+{
+    auto& holder = detail::getSyslogTransportHolder();
+    // -- CRITICAL-SECTION
+    std::lock_guard<std::mutex> lock(holder.mutex);
+    return holder.current;
+}
+
+}} //< NAMESPACE-END: simplelog::backend_syslog
@@ -7,23 +7,51 @@
  **/
 
 #pragma once
-#error "WIP: Not usable yet"
 
 // -- INCLUDES:
-#include <systemd/sd-journal.h>
 #include "simplelog/backend/systemd_journal/ModuleRegistry.hpp"
 #include "simplelog/backend/systemd_journal/Module.hpp"
+#include "simplelog/detail/StringifyMacro.hpp"
 
 #ifdef SIMPLELOG_BACKEND_LOG
 #error "ALREADY_DEFINED: SIMPLELOG_BACKEND_LOG"
 #endif
+// -- AUTO-CONFIGURE:
+#ifndef SIMPLELOG_BACKEND_SYSTEMD_JOURNAL__USE_SOURCE_LOCATION
+#define SIMPLELOG_BACKEND_SYSTEMD_JOURNAL__USE_SOURCE_LOCATION 1
+#endif
 
 // --------------------------------------------------------------------------
 // LOGGING BACKEND MACROS
 // --------------------------------------------------------------------------
-#define SIMPLELOG_BACKEND_DEFINE_MODULE(module, name) auto module = ::simplelog::backend_systemd_journal::useOrCreateModule(name)
-#define SIMPLELOG_BACKEND_LOG(module, level, ...)       module.log(level, __VA_ARGS__)
-#define SIMPLELOG_BACKEND_LOG0(module, level, message)  module.log(level, message)
+/**
+ * @macro SIMPLELOG_BACKEND_DEFINE_MODULE(module, name)
+ * Defines a logging module (as ModuleHandle).
+ * @note The module name must be a string literal (hash is computed at compile-time).
+ **/
+#define SIMPLELOG_BACKEND_DEFINE_MODULE(module, name) \
+    auto module = ::simplelog::backend_systemd_journal::useOrCreateModule(SIMPLELOG_BACKEND_MODULE_NAME(name))
+
+/**
+ * @macro SIMPLELOG_BACKEND_LOG(module, level, ...)
+ * Sends a log-record with structured fields to the journal.
+ *
+ * SIMPLELOG_BACKEND_SYSTEMD_JOURNAL__USE_SOURCE_LOCATION=1:
+ *   Adds the fields CODE_FILE, CODE_LINE, CODE_FUNC (of the log statement).
+ *   CODE_FILE and CODE_LINE are string literals (built at compile-time).
+ **/
+#if SIMPLELOG_BACKEND_SYSTEMD_JOURNAL__USE_SOURCE_LOCATION
+#  define SIMPLELOG_BACKEND_SYSTEMD_JOURNAL_SOURCE_LOCATION \
+    ::simplelog::backend_systemd_journal::SourceLocation{ \
+        "CODE_FILE=" __FILE__, "CODE_LINE=" STRINGIFY(__LINE__), __func__}
+#else
+#  define SIMPLELOG_BACKEND_SYSTEMD_JOURNAL_SOURCE_LOCATION \
+    ::simplelog::backend_systemd_journal::SourceLocation{}
+#endif
+#define SIMPLELOG_BACKEND_LOG(module, level, ...) \
+    module->log(SIMPLELOG_BACKEND_SYSTEMD_JOURNAL_SOURCE_LOCATION, level, __VA_ARGS__)
+#define SIMPLELOG_BACKEND_LOG0(module, level, message) \
+    module->log(SIMPLELOG_BACKEND_SYSTEMD_JOURNAL_SOURCE_LOCATION, level, message)
 
 // --------------------------------------------------------------------------
 // LOGGING BACKEND: LEVEL DEFINITIONS
@@ -10,9 +10,29 @@
 
 #pragma once
 
+// -- AUTO-CONFIGURE:
+// SIMPLELOG_BACKEND_SYSTEMD_JOURNAL__USE_LIBSYSTEMD=0:
+//   Uses the native journal protocol only (no libsystemd link dependency).
+#ifndef SIMPLELOG_BACKEND_SYSTEMD_JOURNAL__USE_LIBSYSTEMD
+#define SIMPLELOG_BACKEND_SYSTEMD_JOURNAL__USE_LIBSYSTEMD 1
+#endif
+
 // -- INCLUDES:
 #include "simplelog/backend/common/ModuleBase.hpp"
+#include "simplelog/backend/common/ThreadLevelOverride.hpp"
+#include "simplelog/backend/common/DiagnosticContext.hpp"
+#include "simplelog/backend/common/FlightRecorder.hpp"
+#include <syslog.h>     //< USE: LOG_PRIMASK, LOG_ERR, ...
+#include "simplelog/backend/systemd_journal/Transport.hpp"
+#if SIMPLELOG_BACKEND_SYSTEMD_JOURNAL__USE_LIBSYSTEMD
 #include <systemd/sd-journal.h>
+#endif
+#include <sys/uio.h>    //< USE: iovec
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
 #include <fmt/format.h>
 
 
@@ -21,47 +41,232 @@
 // --------------------------------------------------------------------------
 namespace simplelog { namespace backend_systemd_journal {
 
+using FlightRecord = simplelog::backend_common::FlightRecord;
+
+/**
+ * @struct SourceLocation
+ * Location of the log statement (as journal fields).
+ * @note file, line: Complete fields as string literals (as: "CODE_LINE=42").
+ **/
+struct SourceLocation
+{
+    std::string_view file;              //< As: "CODE_FILE=" __FILE__
+    std::string_view line;              //< As: "CODE_LINE=" STRINGIFY(__LINE__)
+    const char* function = nullptr;     //< As: __func__
+};
+
+namespace detail {
+
+using JournalFields = fmt::basic_memory_buffer<iovec, 16>;
+
+inline void addField(JournalFields& fields, const char* data, std::size_t size)
+{
+    fields.push_back(iovec{const_cast<char*>(data), size});
+}
+
+inline void appendText(fmt::memory_buffer& buffer, std::string_view text)
+{
+    buffer.append(text.data(), text.data() + text.size());
+}
+
+//! Returns the static PRIORITY field for this level.
+inline std::string_view getPriorityField(int level)
+{
+    static constexpr std::string_view priorityFields[] = {
+        "PRIORITY=0", "PRIORITY=1", "PRIORITY=2", "PRIORITY=3",
+        "PRIORITY=4", "PRIORITY=5", "PRIORITY=6", "PRIORITY=7"
+    };
+    return priorityFields[level & LOG_PRIMASK];
+}
+
+/**
+ * Sends the journal fields:
+ *
+ *   - With the JournalTransport (if used).
+ *   - OTHERWISE: With sd_journal_sendv() (or the default JournalTransport).
+ **/
+inline int sendJournalFields(const iovec* fields, int count)
+{
+    if (auto* transport = getJournalTransport()) {
+        return transport->send(fields, count) ? 0 : -errno;
+    }
+#if SIMPLELOG_BACKEND_SYSTEMD_JOURNAL__USE_LIBSYSTEMD
+    // -- HINT: "(sd_journal_sendv)" suppresses the macro of <systemd/sd-journal.h>
+    // that would add CODE_FILE/CODE_LINE/CODE_FUNC of this header file.
+    return (sd_journal_sendv)(fields, count);
+#else
+    return getDefaultJournalTransport().send(fields, count) ? 0 : -errno;
+#endif
+}
+
+} //< NAMESPACE-END: detail
+
+/**
+ * Sends a log-record with structured fields to the journal:
+ * MESSAGE, PRIORITY, SIMPLELOG_MODULE, CODE_FILE, CODE_LINE, CODE_FUNC
+ * and the fields of the DiagnosticContext.
+ *
+ * The message is formatted once (by formatMessage) into the inline buffer.
+ * The fields (iovecs) point into this buffer or to static strings.
+ * Therefore, no std::string is created (no heap allocation for small records).
+ * @return 0 on success. Otherwise, a negative errno value.
+ **/
+template<typename FormatFunc>
+inline int sendToJournal(int level, std::string_view moduleName,
+                         const SourceLocation& location, FormatFunc formatMessage)
+{
+    fmt::memory_buffer buffer;
+    detail::appendText(buffer, "MESSAGE=");
+    formatMessage(buffer);
+    const auto messageEnd = buffer.size();
+    if (!moduleName.empty()) {
+        detail::appendText(buffer, "SIMPLELOG_MODULE=");
+        detail::appendText(buffer, moduleName);
+    }
+    const auto moduleEnd = buffer.size();
+    if (location.function) {
+        detail::appendText(buffer, "CODE_FUNC=");
+        detail::appendText(buffer, location.function);
+    }
+
+    // -- FIELDS: Buffer does not grow anymore (pointers stay valid).
+    const auto priority = detail::getPriorityField(level);
+    detail::JournalFields fields;
+    detail::addField(fields, buffer.data(), messageEnd);
+    detail::addField(fields, priority.data(), priority.size());
+    if (moduleEnd > messageEnd) {
+        detail::addField(fields, buffer.data() + messageEnd, moduleEnd - messageEnd);
+    }
+    if (!location.file.empty()) {
+        detail::addField(fields, location.file.data(), location.file.size());
+        detail::addField(fields, location.line.data(), location.line.size());
+    }
+    if (buffer.size() > moduleEnd) {
+        detail::addField(fields, buffer.data() + moduleEnd, buffer.size() - moduleEnd);
+    }
+    if (simplelog::backend_common::hasDiagnosticContext()) {
+        using simplelog::backend_common::DiagnosticContext;
+        for (const auto& contextField : DiagnosticContext::current().getJournalFields()) {
+            detail::addField(fields, contextField.data(), contextField.size());
+        }
+    }
+    return detail::sendJournalFields(fields.data(), static_cast<int>(fields.size()));
+}
+
+//! Sends an already formatted log-record (as: flight recorder record).
+inline int sendToJournal(int level, std::string_view moduleName, std::string_view message)
+{
+    return sendToJournal(level, moduleName, SourceLocation{},
+        [message](fmt::memory_buffer& buffer) {
+            detail::appendText(buffer, message);
+        });
+}
+
+//! Formats captured log-records (like: Module::log()).
+struct FlightRecordFormatter
+{
+    template<typename FormatT, typename... Args>
+    static void format(std::string& text, const FormatT& format, const Args&... args)
+    {
+        text = fmt::vformat(fmt::string_view(format), fmt::make_format_args(args...));
+    }
+};
+
+//! Sends the flight recorder records of this thread (oldest first).
+inline void dumpFlightRecorder()
+{
+    simplelog::backend_common::dumpFlightRecorder(
+        [](const FlightRecord& record, const std::string& text) {
+            sendToJournal(record.level, record.getName(), text);
+        });
+}
+
+//! Sends the flight recorder records of all threads.
+inline void dumpAllFlightRecorders()
+{
+    simplelog::backend_common::dumpAllFlightRecorders(
+        [](const FlightRecord& record, const std::string& text) {
+            sendToJournal(record.level, record.getName(), text);
+        });
+}
+
 /**
  * @class Module
  * Provides a named logging module (logger) to log to systemd-journal.
  * Provides an thin adapter around the systemd-journal API.
  *
  * @see https://man7.org/linux/man-pages/man3/sd_journal_print.3.html
+ * @see https://www.freedesktop.org/software/systemd/man/systemd.journal-fields.html
  **/
 class Module : public simplelog::backend_common::ModuleBase
 {
 public:
-    explicit Module(const std::string& name="")
-        : simplelog::backend_common::ModuleBase(name, LOG_WARNING)
-    {}
-    explicit Module(const std::string& name, int level)
-        : simplelog::backend_common::ModuleBase(name, level)
+    using ModuleId = simplelog::backend_common::ModuleId;
+    using ModuleSlot = simplelog::backend_common::ModuleSlot;
+
+public:
+    Module(std::string name, ModuleId id, ModuleSlot slot)
+        : simplelog::backend_common::ModuleBase(std::move(name), id, slot)
     {}
 
     inline bool isLevelEnabled(int level) const
     {
         // LOG_EMERG=0, ..., LOG_DEBUG=7
-        return (level <= getLevel());
+        return (level <= getLevel()) || isLevelEnabledForThisThread(level);
+    }
+
+    //! Checks the level overrides of the current thread (SLOW PATH).
+    bool isLevelEnabledForThisThread(int level) const
+    {
+        int overrideLevel = 0;
+        return simplelog::backend_common::hasThreadLevelOverrides() &&
+               simplelog::backend_common::findThreadLevelOverride(getName(), overrideLevel) &&
+               (level <= overrideLevel);
     }
     void setMinLevel(int minLevel)
     {
-        if (isLevelEnabled(minLevel)) {
+        if (minLevel <= getLevel()) {
             // -- INCREASE-LEVEL: To MIN-LEVEL (from SAME-LEVEL or LOWER-LEVEL).
             setLevel(minLevel);
         }
     }
 
     template<typename... Args>
-    void log(int level, const Args& ... args)
+    void log(const SourceLocation& location, int level, const Args& ... args)
     {
         if (isLevelEnabled(level)) {
-            // -- HINT: Need format string part and args.
-            // OTHERWISE: Compiler will complain with -Wformat-security.
-            std::string text = fmt::format(args...);
-            sd_journal_print(level, "%s", text.c_str());
-            // MAYBE: sd_journal_printv(level, "%s", text.c_str());
+            if (!isWithinBudget()) {
+                return;     //< OVER BUDGET: Before formatting and sending.
+            }
+            if ((level <= LOG_ERR) && simplelog::backend_common::hasFlightRecords()) {
+                dumpFlightRecorder();
+            }
+            sendToJournal(level, getName(), location,
+                [&](fmt::memory_buffer& buffer) {
+                    fmt::format_to(std::back_inserter(buffer), args...);
+                });
+            countRecord();
+        } else if (simplelog::backend_common::isFlightRecorderEnabled()) {
+            simplelog::backend_common::recordInFlightRecorder<FlightRecordFormatter>(
+                getName(), level, args...);
         }
     }
+
+    template<typename... Args>
+    void log(int level, const Args& ... args)
+    {
+        log(SourceLocation{}, level, args...);
+    }
+
+protected:
+    void sendBudgetSummary(std::uint64_t droppedCount) override
+    {
+        sendToJournal(LOG_WARNING, getName(), SourceLocation{},
+            [&](fmt::memory_buffer& buffer) {
+                fmt::format_to(std::back_inserter(buffer),
+                    "{} log-records dropped by simplelog budget (module: {})", droppedCount, getName());
+            });
+    }
 };
 
 }} //< NAMESPACE-END: simplelog::backend_systemd_journal
@@ -1,11 +1,6 @@
 /**
- * @file simplelog/backend/spdlog/LogBackendMacros.hpp
- *
- * Simple example how a generic logging framework w/ different logging
- * subsystems could look like.
- *
- * @see https://github.com/gabime/spdlog
- * @see https://github.com/fmtlib/fmt
+ * @file simplelog/backend/systemd_journal/ModuleRegistry.hpp
+ * Provides the ModuleRegistry for the systemd_journal backend.
  **/
 
 #pragma once
@@ -13,7 +8,6 @@
 // -- INCLUDES:
 #include "simplelog/backend/systemd_journal/Module.hpp"
 #include "simplelog/backend/common/ModuleRegistry.hpp"
-#include <memory>
 
 
 // --------------------------------------------------------------------------
@@ -21,18 +15,26 @@
 // --------------------------------------------------------------------------
 namespace simplelog { namespace backend_systemd_journal {
 
-using ModulePtr = std::shared_ptr<simplelog::backend_systemd_journal::Module>;
 using ModuleRegistry = simplelog::backend_common::ModuleRegistry<Module>;
+using ModulePtr = ModuleRegistry::ModulePtr;   //< ModuleHandle (no refcount)
+using ModuleId = simplelog::backend_common::ModuleId;
 
-// -- FORWARD-DECLARATION:
-// ModuleRegistry& getModuleRegistry();
-ModuleRegistry& getModuleRegistry()
+//! Provides access to the ModuleRegistry instance.
+//! @note HEADER-ONLY: inline (one instance in all translation units).
+inline ModuleRegistry& getModuleRegistry()
 {
     static ModuleRegistry theRegistry;
     return theRegistry;
 }
 
-inline ModulePtr useOrCreateModule(const std::string& name)
+using ModuleName = simplelog::backend_common::ModuleName;
+
+/**
+ * Use existing module or create a new one with this name.
+ * @param name  Module name (hash of a string literal is computed at compile-time).
+ * @return ModuleHandle to the module (owned by the ModuleRegistry).
+ **/
+inline ModulePtr useOrCreateModule(const ModuleName& name)
 {
     return getModuleRegistry().useOrCreateModule(name);
 }
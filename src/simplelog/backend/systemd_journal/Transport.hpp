@@ -0,0 +1,398 @@
+/**
+ * @file simplelog/backend/systemd_journal/Transport.hpp
+ * Provides a native journal protocol client (without libsystemd).
+ *
+ * The JournalTransport sends log-records (as journal fields) over its own
+ * AF_UNIX datagram socket (default: "/run/systemd/journal/socket"):
+ *
+ *   - Each field is sent as "NAME=value\n" (or binary-safe, if the value
+ *     contains a newline: "NAME\n" + 64-bit little-endian size + value + "\n").
+ *   - Connects eagerly and reconnects once if journald restarted.
+ *     Reconnects are rate-limited while journald is gone
+ *     (no reconnect-per-message storm: at most once per reconnect-interval).
+ *   - A record larger than the datagram limit is written into a sealed memfd
+ *     and its file descriptor is sent instead (SCM_RIGHTS).
+ *   - JournalBatch: Sends many log-records with one sendmmsg() call.
+ *
+ * @code
+ *  using namespace simplelog::backend_systemd_journal;
+ *  useJournalTransport(std::make_shared<JournalTransport>());
+ *  SLOG_INFO("Hello Alice");   //< Is sent by the JournalTransport.
+ * @endcode
+ *
+ * @see https://systemd.io/JOURNAL_NATIVE_PROTOCOL/
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fmt/format.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+// --------------------------------------------------------------------------
+// LOGGING BACKEND: JOURNAL TRANSPORT
+// --------------------------------------------------------------------------
+namespace simplelog { namespace backend_systemd_journal {
+
+namespace detail {
+
+//! Appends one field ("NAME=value") in the native journal protocol.
+inline void appendJournalField(fmt::memory_buffer& buffer, std::string_view field)
+{
+    const auto equal = field.find('=');
+    if (equal == std::string_view::npos) {
+        return;     //< INVALID FIELD: Is ignored (as by journald).
+    }
+    const auto value = field.substr(equal + 1);
+    if (value.find('\n') == std::string_view::npos) {
+        buffer.append(field.data(), field.data() + field.size());
+        buffer.push_back('\n');
+        return;
+    }
+    // -- BINARY-SAFE: "NAME\n" + size (uint64, little-endian) + value + "\n"
+    buffer.append(field.data(), field.data() + equal);
+    buffer.push_back('\n');
+    const auto size = static_cast<std::uint64_t>(value.size());
+    for (int i = 0; i < 8; ++i) {
+        buffer.push_back(static_cast<char>((size >> (8 * i)) & 0xFF));
+    }
+    buffer.append(value.data(), value.data() + value.size());
+    buffer.push_back('\n');
+}
+
+} //< NAMESPACE-END: detail
+
+//! Encodes a log-record (journal fields) in the native journal protocol.
+inline void encodeJournalRecord(fmt::memory_buffer& buffer, const iovec* fields, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        detail::appendJournalField(buffer,
+            std::string_view(static_cast<const char*>(fields[i].iov_base), fields[i].iov_len));
+    }
+}
+
+/**
+ * @class JournalBatch
+ * Collects encoded log-records that are sent with one sendmmsg() call.
+ **/
+class JournalBatch
+{
+private:
+    fmt::memory_buffer m_buffer;
+    std::vector<std::size_t> m_ends;
+
+public:
+    std::size_t size() const { return m_ends.size(); }
+    bool empty() const { return m_ends.empty(); }
+
+    void add(const iovec* fields, int count)
+    {
+        encodeJournalRecord(m_buffer, fields, count);
+        m_ends.push_back(m_buffer.size());
+    }
+
+    std::string_view at(std::size_t index) const
+    {
+        const auto begin = (index == 0) ? 0 : m_ends[index - 1];
+        return std::string_view(m_buffer.data() + begin, m_ends[index] - begin);
+    }
+
+    void clear()
+    {
+        m_buffer.clear();
+        m_ends.clear();
+    }
+};
+
+/**
+ * @class JournalTransport
+ * Sends log-records to journald (AF_UNIX, SOCK_DGRAM, native protocol).
+ * @note Thread-safe: A datagram is sent atomically (no lock is needed).
+ **/
+class JournalTransport
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr const char* DEFAULT_PATH = "/run/systemd/journal/socket";
+    static constexpr std::size_t MAX_BATCH_SIZE = 64;
+    static constexpr std::chrono::milliseconds DEFAULT_RECONNECT_INTERVAL{500};
+
+private:
+    std::string m_path;
+    std::atomic<int> m_fd;
+    std::mutex m_connectMutex;
+    std::atomic<Clock::rep> m_reconnectInterval;    //< As: Clock::duration
+    std::atomic<Clock::rep> m_nextReconnectTime;    //< As: Clock::time_point
+    std::atomic<std::size_t> m_memfdCount;
+
+public:
+    explicit JournalTransport(std::string path = DEFAULT_PATH)
+        : m_path(std::move(path)),
+          m_fd(-1),
+          m_connectMutex(),
+          m_reconnectInterval(Clock::duration(DEFAULT_RECONNECT_INTERVAL).count()),
+          m_nextReconnectTime(0),
+          m_memfdCount(0)
+    {
+        reconnect();    //< EAGER: Not on first use.
+    }
+
+    ~JournalTransport()
+    {
+        const int fd = m_fd.exchange(-1);
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    JournalTransport(const JournalTransport&) = delete;
+    JournalTransport& operator=(const JournalTransport&) = delete;
+
+    const std::string& getPath() const { return m_path; }
+    bool isConnected() const { return m_fd.load() >= 0; }
+
+    //! Number of log-records that were sent with a memfd (too large for a datagram).
+    std::size_t getMemfdCount() const { return m_memfdCount.load(std::memory_order_relaxed); }
+
+    //! Sets the min. time between reconnect attempts (while journald is gone).
+    void setReconnectInterval(Clock::duration interval)
+    {
+        m_reconnectInterval.store(interval.count(), std::memory_order_relaxed);
+    }
+
+    /**
+     * (Re)connects the socket to journald.
+     * @note The file descriptor number is kept (with dup2()).
+     *       Therefore, concurrent senders never use a closed descriptor.
+     **/
+    bool reconnect()
+    {
+        const int newFd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (newFd < 0) {
+            return false;
+        }
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, m_path.c_str(), sizeof(address.sun_path) - 1);
+        if (::connect(newFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            ::close(newFd);
+            return false;
+        }
+        // -- CRITICAL-SECTION
+        std::lock_guard<std::mutex> lock(m_connectMutex);
+        const int fd = m_fd.load();
+        if (fd < 0) {
+            m_fd.store(newFd);
+        } else {
+            ::dup2(newFd, fd);
+            ::close(newFd);
+        }
+        return true;
+    }
+
+    //! Encodes and sends one log-record (as: sd_journal_sendv()).
+    bool send(const iovec* fields, int count)
+    {
+        fmt::memory_buffer buffer;
+        encodeJournalRecord(buffer, fields, count);
+        return sendEncoded(std::string_view(buffer.data(), buffer.size()));
+    }
+
+    //! Sends one already encoded log-record (reconnects once on failure).
+    bool sendEncoded(std::string_view data)
+    {
+        for (int retry = 0; retry < 2; ++retry) {
+            const int fd = m_fd.load();
+            if ((fd >= 0) && (::send(fd, data.data(), data.size(), MSG_NOSIGNAL) >= 0)) {
+                return true;
+            }
+            if ((fd >= 0) && isTooLarge()) {
+                return sendWithMemfd(fd, data);
+            }
+            if (!shouldReconnect(fd) || !tryReconnect()) {
+                break;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Sends all log-records of the batch (with sendmmsg()).
+     * @return Number of sent log-records.
+     **/
+    std::size_t send(const JournalBatch& batch)
+    {
+        std::size_t sent = 0;
+        int retries = 0;
+        while (sent < batch.size()) {
+            const auto count = std::min(batch.size() - sent, MAX_BATCH_SIZE);
+            iovec parts[MAX_BATCH_SIZE];
+            mmsghdr messages[MAX_BATCH_SIZE];
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto data = batch.at(sent + i);
+                parts[i].iov_base = const_cast<char*>(data.data());
+                parts[i].iov_len = data.size();
+                messages[i] = mmsghdr{};
+                messages[i].msg_hdr.msg_iov = &parts[i];
+                messages[i].msg_hdr.msg_iovlen = 1;
+            }
+            const int fd = m_fd.load();
+            const int result = (fd < 0) ? -1 :
+                ::sendmmsg(fd, messages, static_cast<unsigned int>(count), MSG_NOSIGNAL);
+            if (result > 0) {
+                sent += static_cast<std::size_t>(result);
+                continue;
+            }
+            if ((fd >= 0) && isTooLarge()) {
+                // -- LARGE RECORD: Is first of the remaining batch.
+                if (!sendWithMemfd(fd, batch.at(sent))) {
+                    break;
+                }
+                ++sent;
+                continue;
+            }
+            if ((++retries > 1) || !shouldReconnect(fd) || !tryReconnect()) {
+                break;
+            }
+        }
+        return sent;
+    }
+
+private:
+    //! Reconnects, but at most once per reconnect-interval (while it fails).
+    bool tryReconnect()
+    {
+        const auto now = Clock::now().time_since_epoch().count();
+        if (now < m_nextReconnectTime.load(std::memory_order_relaxed)) {
+            return false;   //< RATE-LIMITED: Last reconnect failed recently.
+        }
+        if (reconnect()) {
+            return true;
+        }
+        m_nextReconnectTime.store(now + m_reconnectInterval.load(std::memory_order_relaxed),
+                                  std::memory_order_relaxed);
+        return false;
+    }
+
+    static bool shouldReconnect(int fd)
+    {
+        // -- JOURNALD RESTARTED: Socket is no longer connected.
+        return (fd < 0) || (errno == ECONNREFUSED) || (errno == ENOTCONN) ||
+               (errno == ENOENT) || (errno == EBADF);
+    }
+
+    static bool isTooLarge()
+    {
+        return (errno == EMSGSIZE) || (errno == ENOBUFS);
+    }
+
+    /**
+     * Sends a large log-record as sealed memfd (SCM_RIGHTS).
+     * journald reads the record from the memfd (same as libsystemd does).
+     **/
+    bool sendWithMemfd(int fd, std::string_view data)
+    {
+        const int memfd = ::memfd_create("simplelog-journal", MFD_ALLOW_SEALING | MFD_CLOEXEC);
+        if (memfd < 0) {
+            return false;
+        }
+        std::size_t offset = 0;
+        while (offset < data.size()) {
+            const auto written = ::write(memfd, data.data() + offset, data.size() - offset);
+            if (written <= 0) {
+                if ((written < 0) && (errno == EINTR)) {
+                    continue;
+                }
+                ::close(memfd);
+                return false;
+            }
+            offset += static_cast<std::size_t>(written);
+        }
+        if (::fcntl(memfd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0) {
+            ::close(memfd);
+            return false;
+        }
+        union {
+            cmsghdr header;
+            char data[CMSG_SPACE(sizeof(int))];
+        } control{};
+        msghdr message{};
+        message.msg_control = &control;
+        message.msg_controllen = sizeof(control);
+        cmsghdr* header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(header), &memfd, sizeof(int));
+        const bool sent = (::sendmsg(fd, &message, MSG_NOSIGNAL) >= 0);
+        ::close(memfd);
+        if (sent) {
+            m_memfdCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        return sent;
+    }
+};
+
+using JournalTransportPtr = std::shared_ptr<JournalTransport>;
+
+namespace detail {
+
+inline std::atomic<JournalTransport*> currentJournalTransport(nullptr);
+
+//! Keeps all used transports alive (senders use the raw pointer).
+inline std::vector<JournalTransportPtr>& getPinnedJournalTransports()
+{
+    static std::vector<JournalTransportPtr> theTransports;
+    return theTransports;
+}
+
+} //< NAMESPACE-END: detail
+
+/**
+ * Uses this transport for all modules (instead of sd_journal_sendv()).
+ * @param transport  Transport to use (or nullptr: Use the default again).
+ * @note A replaced transport is kept alive (until the program ends).
+ **/
+inline void useJournalTransport(JournalTransportPtr transport)
+{
+    static std::mutex theMutex;
+    // -- CRITICAL-SECTION
+    std::lock_guard<std::mutex> lock(theMutex);
+    if (transport) {
+        detail::getPinnedJournalTransports().push_back(transport);
+    }
+    detail::currentJournalTransport.store(transport.get(), std::memory_order_release);
+}
+
+//! Returns the used transport (or nullptr if the default is used).
+inline JournalTransport* getJournalTransport()
+{
+    return detail::currentJournalTransport.load(std::memory_order_acquire);
+}
+
+//! Returns the default transport (used without libsystemd).
+inline JournalTransport& getDefaultJournalTransport()
+{
+    static JournalTransport theTransport;
+    return theTransport;
+}
+
+}} //< NAMESPACE-END: simplelog::backend_systemd_journal
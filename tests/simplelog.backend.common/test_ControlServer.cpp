@@ -0,0 +1,100 @@
+/**
+ * @file tests/simplelog.backend.common/test_ControlServer.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/backend/common/ControlServer.hpp"
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using simplelog::backend_common::ControlServer;
+using simplelog::backend_common::sendControlCommand;
+
+/**
+ * Provides a temporary directory for the socket file (removed at scope-exit).
+ **/
+struct TempDirectory
+{
+    char path[32] = "/tmp/test_simplelog.XXXXXX";
+
+    TempDirectory() { REQUIRE(::mkdtemp(path) != nullptr); }
+    ~TempDirectory() { ::rmdir(path); }
+    std::string makePath(const std::string& filename) const
+    {
+        return std::string(path) + "/" + filename;
+    }
+};
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_common.ControlServer");
+TEST_CASE("ControlServer: Should execute registered command with args")
+{
+    ControlServer server("UNUSED");
+    server.addCommand("echo", "echo <args>...", [](const ControlServer::Arguments& args) {
+        std::string text;
+        for (const auto& arg : args) {
+            text += "[" + arg + "]";
+        }
+        return text;
+    });
+
+    CHECK_EQ(server.execute("echo foo  bar"), "[foo][bar]");
+    CHECK_EQ(server.execute("help"), "echo <args>...\nhelp\n");
+    CHECK_EQ(server.execute("UNKNOWN"), "ERROR: Unknown command: UNKNOWN\n");
+    CHECK_EQ(server.execute("  "), "ERROR: Missing command (use: help)\n");
+}
+
+TEST_CASE("ControlServer: Should return an exception of the handler as ERROR")
+{
+    ControlServer server("UNUSED");
+    server.addCommand("fail", "fail", [](const ControlServer::Arguments&) -> std::string {
+        throw std::runtime_error("BAD_COMMAND");
+    });
+    CHECK_EQ(server.execute("fail"), "ERROR: BAD_COMMAND\n");
+}
+
+TEST_CASE("ControlServer: Should receive commands on socket")
+{
+    TempDirectory tempDirectory;
+    const auto socketPath = tempDirectory.makePath("control.sock");
+    int counter = 0;
+    ControlServer server(socketPath);
+    server.addCommand("count", "count", [&counter](const ControlServer::Arguments&) {
+        return std::to_string(++counter) + "\n";
+    });
+    REQUIRE(server.start());
+    CHECK(server.isRunning());
+
+    // -- ACCESS: Only by the owner.
+    struct stat info{};
+    REQUIRE_EQ(::stat(socketPath.c_str(), &info), 0);
+    CHECK_EQ((info.st_mode & 0777), 0600);
+
+    CHECK_EQ(sendControlCommand(socketPath, "count"), "1\n");
+    CHECK_EQ(sendControlCommand(socketPath, "count"), "2\n");
+    CHECK_EQ(sendControlCommand(socketPath, "OOPS"), "ERROR: Unknown command: OOPS\n");
+
+    // -- STOP: Removes the socket file.
+    server.stop();
+    CHECK_FALSE(server.isRunning());
+    CHECK_NE(::access(socketPath.c_str(), F_OK), 0);
+    CHECK_EQ(sendControlCommand(socketPath, "count").rfind("ERROR:", 0), 0);
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
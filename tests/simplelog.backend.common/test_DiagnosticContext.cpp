@@ -0,0 +1,77 @@
+/**
+ * @file tests/simplelog.backend.common/test_DiagnosticContext.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/backend/common/DiagnosticContext.hpp"
+#include <string>
+#include <thread>
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using simplelog::backend_common::DiagnosticContext;
+using simplelog::backend_common::DiagnosticContextScope;
+using simplelog::backend_common::getDiagnosticContextPrefix;
+using simplelog::backend_common::hasDiagnosticContext;
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_common.DiagnosticContext");
+TEST_CASE("DiagnosticContextScope: Should render prefix of nested scopes")
+{
+    CHECK_FALSE(hasDiagnosticContext());
+    CHECK_EQ(getDiagnosticContextPrefix(), "");
+    {
+        DiagnosticContextScope scope1("request", "42");
+        CHECK(hasDiagnosticContext());
+        CHECK_EQ(getDiagnosticContextPrefix(), "[request=42] ");
+        {
+            DiagnosticContextScope scope2("tenant", "acme");
+            CHECK_EQ(getDiagnosticContextPrefix(), "[request=42 tenant=acme] ");
+        }
+        CHECK_EQ(getDiagnosticContextPrefix(), "[request=42] ");
+    }
+    CHECK_FALSE(hasDiagnosticContext());
+    CHECK_EQ(getDiagnosticContextPrefix(), "");
+}
+
+TEST_CASE("DiagnosticContext: Should reuse cached prefix until context changes")
+{
+    DiagnosticContextScope scope1("request", "42");
+    const auto* prefixData = getDiagnosticContextPrefix().data();
+    CHECK_EQ(getDiagnosticContextPrefix().data(), prefixData);   //< NOT RENDERED AGAIN.
+}
+
+TEST_CASE("DiagnosticContext: Should provide journal fields")
+{
+    DiagnosticContextScope scope1("request-id", "42");
+    DiagnosticContextScope scope2("_tenant", "acme");
+    const auto& fields = DiagnosticContext::current().getJournalFields();
+    REQUIRE_EQ(fields.size(), 2);
+    CHECK_EQ(fields[0], "REQUEST_ID=42");
+    CHECK_EQ(fields[1], "TENANT=acme");
+}
+
+TEST_CASE("DiagnosticContext: Should not be shared with other threads")
+{
+    DiagnosticContextScope scope1("request", "42");
+    std::string otherThreadPrefix("UNKNOWN");
+    std::thread otherThread([&]() {
+        otherThreadPrefix = getDiagnosticContextPrefix();
+    });
+    otherThread.join();
+    CHECK_EQ(otherThreadPrefix, "");
+    CHECK_EQ(getDiagnosticContextPrefix(), "[request=42] ");
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
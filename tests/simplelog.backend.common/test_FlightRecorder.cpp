@@ -0,0 +1,143 @@
+/**
+ * @file tests/simplelog.backend.common/test_FlightRecorder.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/backend/common/FlightRecorder.hpp"
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using simplelog::backend_common::FlightRecord;
+using simplelog::backend_common::FormatLiteral;
+using simplelog::backend_common::recordInFlightRecorder;
+using simplelog::backend_common::dumpFlightRecorder;
+using simplelog::backend_common::dumpAllFlightRecorders;
+using simplelog::backend_common::hasFlightRecords;
+
+//! Formats as: "<format>|<arg1>|<arg2>..."
+struct JoinFormatter
+{
+    template<typename FormatT, typename... Args>
+    static void format(std::string& text, const FormatT& format, const Args&... args)
+    {
+        std::ostringstream output;
+        output << format;
+        ((output << "|" << args), ...);
+        text = output.str();
+    }
+};
+
+std::vector<std::string> dumpThisThread()
+{
+    std::vector<std::string> lines;
+    dumpFlightRecorder([&lines](const FlightRecord& record, const std::string& text) {
+        lines.push_back(std::string(record.getName()) + ":" + std::to_string(record.level) + ":" + text);
+    });
+    return lines;
+}
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_common.FlightRecorder");
+TEST_CASE("FlightRecorder: Should capture args in binary form and render them on dump")
+{
+    std::string dynamicText("Alice");
+    const char* const dynamicFormat = "DYNAMIC_FORMAT";
+    recordInFlightRecorder<JoinFormatter>("foo", 7, "Message_1");
+    recordInFlightRecorder<JoinFormatter>("foo", 7, "Message_2", 42, 1.5, dynamicText);
+    dynamicText = "Bob";    //< CHANGED: After capture.
+    recordInFlightRecorder<JoinFormatter>("bar", 6, dynamicFormat, "Charly");
+    CHECK(hasFlightRecords());
+
+    const auto lines = dumpThisThread();
+    REQUIRE_EQ(lines.size(), 3);
+    CHECK_EQ(lines[0], "foo:7:Message_1");
+    CHECK_EQ(lines[1], "foo:7:Message_2|42|1.5|Alice");
+    CHECK_EQ(lines[2], "bar:6:DYNAMIC_FORMAT|Charly");
+    CHECK_FALSE(hasFlightRecords());
+    CHECK(dumpThisThread().empty());
+}
+
+TEST_CASE("FlightRecorder: Should copy a format string that is no marked literal")
+{
+    char buffer[] = "FORMAT_1";     //< ARRAY: But no string literal.
+    std::string formatText("FORMAT_2");
+    recordInFlightRecorder<JoinFormatter>("foo", 7, buffer, 1);
+    recordInFlightRecorder<JoinFormatter>("foo", 7, formatText, 2);
+    buffer[7] = 'X';                //< CHANGED: After capture.
+    formatText = "CHANGED";
+
+    const auto lines = dumpThisThread();
+    REQUIRE_EQ(lines.size(), 2);
+    CHECK_EQ(lines[0], "foo:7:FORMAT_1|1");
+    CHECK_EQ(lines[1], "foo:7:FORMAT_2|2");
+}
+
+TEST_CASE("FlightRecorder: Should capture a FormatLiteral as pointer")
+{
+    recordInFlightRecorder<JoinFormatter>("foo", 7, FormatLiteral{"LITERAL"}, 42, "Alice");
+    recordInFlightRecorder<JoinFormatter>("foo", 7, FormatLiteral{"LITERAL_ONLY"});
+
+    std::vector<const char*> formats;
+    std::vector<std::string> lines;
+    dumpFlightRecorder([&](const FlightRecord& record, const std::string& text) {
+        formats.push_back(record.format);
+        lines.push_back(text);
+    });
+    REQUIRE_EQ(lines.size(), 2);
+    CHECK_EQ(lines[0], "LITERAL|42|Alice");
+    CHECK_EQ(lines[1], "LITERAL_ONLY");
+    CHECK(formats[0] != nullptr);
+}
+
+TEST_CASE("FlightRecorder: Should format a too long format string on capture")
+{
+    const std::string longFormat(FlightRecord::DATA_CAPACITY + 10, 'F');
+    recordInFlightRecorder<JoinFormatter>("foo", 7, longFormat, 1);
+
+    const auto lines = dumpThisThread();
+    REQUIRE_EQ(lines.size(), 1);
+    CHECK_EQ(lines[0], "foo:7:" + std::string(FlightRecord::DATA_CAPACITY - 1, 'F'));
+}
+
+TEST_CASE("FlightRecorder: Should keep only the last records")
+{
+    const auto capacity = SIMPLELOG_BACKEND_COMMON__FLIGHT_RECORDER_CAPACITY;
+    for (int i = 0; i < capacity + 2; ++i) {
+        recordInFlightRecorder<JoinFormatter>("foo", 7, "Message", i);
+    }
+    const auto lines = dumpThisThread();
+    REQUIRE_EQ(lines.size(), capacity);
+    CHECK_EQ(lines.front(), "foo:7:Message|2");
+    CHECK_EQ(lines.back(), "foo:7:Message|" + std::to_string(capacity + 1));
+}
+
+TEST_CASE("dumpAllFlightRecorders: Should dump records of other threads")
+{
+    std::vector<std::string> lines;
+    std::thread otherThread([&lines]() {
+        recordInFlightRecorder<JoinFormatter>("other", 7, "Message_1");
+        dumpAllFlightRecorders([&lines](const FlightRecord&, const std::string& text) {
+            lines.push_back(text);
+        });
+    });
+    otherThread.join();
+    REQUIRE_EQ(lines.size(), 1);
+    CHECK_EQ(lines[0], "Message_1");
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
@@ -0,0 +1,200 @@
+/**
+ * @file tests/simplelog.backend.common/test_LevelConfig.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/backend/common/LevelConfig.hpp"
+#include "simplelog/backend/common/ConfigFileWatcher.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using simplelog::backend_common::ConfigFileWatcher;
+using simplelog::backend_common::LevelConfig;
+using simplelog::backend_common::LevelSeverity;
+using simplelog::backend_common::matchesModulePattern;
+using simplelog::backend_common::parseLevelConfig;
+using simplelog::backend_common::parseLevelSeverity;
+using simplelog::backend_common::readLevelConfigFile;
+
+LevelConfig parseLevelConfigText(const std::string& text)
+{
+    std::istringstream input(text);
+    return parseLevelConfig(input);
+}
+
+void writeTextFile(const std::string& filename, const std::string& text)
+{
+    std::ofstream output(filename);
+    output << text;
+}
+
+template<typename Condition>
+bool waitUntil(Condition condition)
+{
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!condition() && (std::chrono::steady_clock::now() < timeout)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return condition();
+}
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_common.LevelConfig");
+TEST_CASE("matchesModulePattern: Should match name, prefix pattern or any")
+{
+    CHECK(matchesModulePattern("foo.bar", "foo.bar"));
+    CHECK_FALSE(matchesModulePattern("foo.bar", "foo.bar.baz"));
+    CHECK(matchesModulePattern("foo.*", "foo.bar"));
+    CHECK_FALSE(matchesModulePattern("foo.*", "foo"));
+    CHECK_FALSE(matchesModulePattern("foo.*", "bar.foo"));
+    CHECK(matchesModulePattern("*", "foo"));
+    CHECK(matchesModulePattern("*", ""));
+}
+
+TEST_CASE("parseLevelConfig: Should parse levels and sink names")
+{
+    const auto config = parseLevelConfigText(
+        "# COMMENT: Is ignored.\n"
+        "*         = warn\n"
+        "\n"
+        "  foo.*   =  debug  \n"
+        "db.query  = info : console, file\n"
+        "INVALID_LINE\n"
+        "bar       = \n");
+
+    REQUIRE_EQ(config.size(), 3);
+    CHECK_EQ(config[0].pattern, "*");
+    CHECK_EQ(config[0].level, "warn");
+    CHECK(config[0].sinkNames.empty());
+    CHECK_EQ(config[1].pattern, "foo.*");
+    CHECK_EQ(config[1].level, "debug");
+    CHECK_EQ(config[2].pattern, "db.query");
+    CHECK_EQ(config[2].level, "info");
+    REQUIRE_EQ(config[2].sinkNames.size(), 2);
+    CHECK_EQ(config[2].sinkNames[0], "console");
+    CHECK_EQ(config[2].sinkNames[1], "file");
+}
+
+TEST_CASE("parseLevelSeverity: Should accept the level names of all backends")
+{
+    LevelSeverity severity = LevelSeverity::Off;
+    CHECK(parseLevelSeverity("err", severity));
+    CHECK(severity == LevelSeverity::Error);
+    CHECK(parseLevelSeverity("error", severity));
+    CHECK(severity == LevelSeverity::Error);
+    CHECK(parseLevelSeverity("warn", severity));
+    CHECK(severity == LevelSeverity::Warning);
+    CHECK(parseLevelSeverity("critical", severity));
+    CHECK(severity == LevelSeverity::Critical);
+    CHECK(parseLevelSeverity("trace", severity));
+    CHECK(severity == LevelSeverity::Trace);
+    CHECK_FALSE(parseLevelSeverity("verbose", severity));
+}
+
+TEST_CASE("readLevelConfigFile: Should return empty config for missing file")
+{
+    CHECK(readLevelConfigFile("/UNKNOWN_DIRECTORY/logging.conf").empty());
+}
+
+TEST_CASE("ConfigFileWatcher: Should treat lost events as config file change")
+{
+    using simplelog::backend_common::detail::hasConfigFileEvent;
+    alignas(inotify_event) char buffer[sizeof(inotify_event) + 16] = {};
+    auto* event = reinterpret_cast<inotify_event*>(buffer);
+
+    // -- CASE: Event of other file in the directory.
+    event->mask = IN_CLOSE_WRITE;
+    event->len = 16;
+    std::strcpy(event->name, "other.conf");
+    CHECK_FALSE(hasConfigFileEvent(buffer, sizeof(buffer), "logging.conf"));
+
+    // -- CASE: Event queue overflow (without file name).
+    event->mask = IN_Q_OVERFLOW;
+    event->len = 0;
+    CHECK(hasConfigFileEvent(buffer, sizeof(inotify_event), "logging.conf"));
+}
+
+TEST_CASE("ConfigFileWatcher: Should call callback after config file changed")
+{
+    char directory[] = "/tmp/test_simplelog.XXXXXX";
+    REQUIRE(::mkdtemp(directory) != nullptr);
+    const std::string filename = std::string(directory) + "/logging.conf";
+    writeTextFile(filename, "* = warn\n");
+
+    std::atomic<int> changedCount(0);
+    LevelConfig lastConfig;
+    ConfigFileWatcher watcher(filename, [&](const std::string& path) {
+        lastConfig = readLevelConfigFile(path);
+        ++changedCount;
+    });
+    REQUIRE(watcher.start());
+    CHECK(watcher.isRunning());
+
+    // -- CASE 1: Change file in-place.
+    writeTextFile(filename, "foo.* = debug\n");
+    REQUIRE(waitUntil([&]() { return changedCount >= 1; }));
+
+    // -- CASE 2: Replace file (write tmpfile and rename).
+    const auto countBefore = changedCount.load();
+    const std::string tempFilename = filename + ".tmp";
+    writeTextFile(tempFilename, "bar = error\n");
+    REQUIRE(std::rename(tempFilename.c_str(), filename.c_str()) == 0);
+    REQUIRE(waitUntil([&]() { return changedCount > countBefore; }));
+    watcher.stop();
+    CHECK_FALSE(watcher.isRunning());
+    REQUIRE_EQ(lastConfig.size(), 1);
+    CHECK_EQ(lastConfig[0].pattern, "bar");
+    CHECK_EQ(lastConfig[0].level, "error");
+
+    std::remove(filename.c_str());
+    ::rmdir(directory);
+}
+
+TEST_CASE("ConfigFileWatcher: Should keep running if the callback throws")
+{
+    char directory[] = "/tmp/test_simplelog.XXXXXX";
+    REQUIRE(::mkdtemp(directory) != nullptr);
+    const std::string filename = std::string(directory) + "/logging.conf";
+    writeTextFile(filename, "* = warn\n");
+
+    std::atomic<int> changedCount(0);
+    ConfigFileWatcher watcher(filename, [&](const std::string&) {
+        ++changedCount;
+        throw std::runtime_error("BAD_CONFIG");
+    });
+    REQUIRE(watcher.start());
+    writeTextFile(filename, "foo.* = debug\n");
+    REQUIRE(waitUntil([&]() { return changedCount >= 1; }));
+
+    const auto countBefore = changedCount.load();
+    writeTextFile(filename, "bar = error\n");
+    REQUIRE(waitUntil([&]() { return changedCount > countBefore; }));
+    CHECK(watcher.isRunning());
+    watcher.stop();
+
+    std::remove(filename.c_str());
+    ::rmdir(directory);
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
@@ -0,0 +1,182 @@
+/**
+ * @file tests/simplelog.backend.common/test_ModuleRegistry.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/backend/common/ModuleBase.hpp"
+#include "simplelog/backend/common/ModuleRegistry.hpp"
+#include "simplelog/backend/common/ModuleName.hpp"
+#include <string>
+#include <string_view>
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using simplelog::backend_common::ModuleId;
+using simplelog::backend_common::ModuleName;
+using simplelog::backend_common::ModuleSlot;
+using simplelog::backend_common::ModuleTableChunk;
+
+class TestModule : public simplelog::backend_common::ModuleBase
+{
+public:
+    TestModule(std::string name, ModuleId id, ModuleSlot slot)
+        : simplelog::backend_common::ModuleBase(std::move(name), id, slot)
+    {}
+
+    void log(void) { countRecord(); }
+};
+
+using ModuleRegistry = simplelog::backend_common::ModuleRegistry<TestModule>;
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_common.ModuleRegistry");
+TEST_CASE("ModuleRegistry: Should contain the DEFAULT_MODULE with id=0")
+{
+    ModuleRegistry registry;
+    CHECK_EQ(registry.size(), 1);
+    CHECK(registry.hasModule(""));
+    CHECK_EQ(registry.useOrCreateModuleId(""), 0);
+}
+
+TEST_CASE("useOrCreateModule: Should intern module names as dense ids")
+{
+    ModuleRegistry registry;
+    auto module1 = registry.useOrCreateModule("foo.1");
+    auto module2 = registry.useOrCreateModule("foo.2");
+    CHECK_EQ(module1.getId(), 1);
+    CHECK_EQ(module2.getId(), 2);
+    CHECK_EQ(module1->getName(), "foo.1");
+
+    // -- SAME NAME: Returns same module (and id).
+    auto module3 = registry.useOrCreateModule("foo.1");
+    CHECK(module3 == module1);
+    CHECK_EQ(registry.useOrCreateModuleId("foo.2"), module2.getId());
+    CHECK_EQ(registry.size(), 3);
+}
+
+TEST_CASE("useOrCreateModule: New module should use the default level")
+{
+    ModuleRegistry registry;
+    registry.setDefaultLevel(4);
+    auto module1 = registry.useOrCreateModule("foo");
+    CHECK_EQ(module1->getLevel(), 4);
+
+    module1->setLevel(7);
+    CHECK_EQ(registry.getModuleById(module1.getId())->getLevel(), 7);
+}
+
+TEST_CASE("useOrCreateModule: Modules should keep their address across chunks")
+{
+    ModuleRegistry registry;
+    auto module1 = registry.useOrCreateModule("foo.0");
+    module1->setLevel(3);
+    const std::size_t MANY_MODULES = 3 * ModuleTableChunk::CHUNK_SIZE;
+    for (std::size_t i = 1; i < MANY_MODULES; ++i) {
+        auto module = registry.useOrCreateModule("foo." + std::to_string(i));
+        module->setLevel(static_cast<int>(i % 8));
+    }
+
+    CHECK_EQ(registry.size(), MANY_MODULES + 1);
+    CHECK(registry.useOrCreateModule("foo.0") == module1);
+    CHECK_EQ(module1->getLevel(), 3);
+    auto module2 = registry.useOrCreateModule("foo.130");
+    CHECK_EQ(module2.getId(), 131);
+    CHECK_EQ(module2->getLevel(), 130 % 8);
+}
+
+TEST_CASE("ModuleBase: Counter should count logged records per module")
+{
+    ModuleRegistry registry;
+    auto module1 = registry.useOrCreateModule("foo.1");
+    auto module2 = registry.useOrCreateModule("foo.2");
+    module1->log();
+    module1->log();
+    module2->log();
+
+    CHECK_EQ(module1->getCounter(), 2);
+    CHECK_EQ(module2->getCounter(), 1);
+    module1->resetCounter();
+    CHECK_EQ(module1->getCounter(), 0);
+}
+
+TEST_CASE("ModuleName: Hash of a string literal should be computed at compile-time")
+{
+    constexpr auto NAME = SIMPLELOG_BACKEND_MODULE_NAME("foo.bar");
+    static_assert(NAME.getHash() == simplelog::backend_common::hashModuleName("foo.bar"),
+                  "ModuleName.hash is constexpr");
+    CHECK_EQ(NAME, ModuleName(std::string("foo.bar")));
+    CHECK_NE(NAME, ModuleName("foo.baz"));
+}
+
+TEST_CASE("useOrCreateModule: Should find module by string, string_view or literal")
+{
+    ModuleRegistry registry;
+    auto module1 = registry.useOrCreateModule(SIMPLELOG_BACKEND_MODULE_NAME("foo.1"));
+    const std::string name("foo.1");
+    const std::string_view nameView(name);
+
+    CHECK(registry.hasModule(name));
+    CHECK(registry.hasModule(nameView));
+    CHECK(registry.useOrCreateModule(name) == module1);
+    CHECK(registry.useOrCreateModule(nameView) == module1);
+    CHECK(registry.useOrCreateModule("foo.1") == module1);
+    CHECK_FALSE(registry.hasModule("foo"));
+    CHECK_EQ(registry.size(), 2);
+}
+
+TEST_CASE("getModuleById: Should return nullptr for unknown id")
+{
+    ModuleRegistry registry;
+    CHECK_FALSE(registry.getModuleById(42));
+    CHECK(registry.getModuleById(0));
+}
+
+TEST_CASE("applyToModuleIf: Should apply function to matching modules")
+{
+    ModuleRegistry registry;
+    auto module1 = registry.useOrCreateModule("foo.1");
+    auto module2 = registry.useOrCreateModule("bar.1");
+    module1->setLevel(1);
+    module2->setLevel(1);
+
+    using ModulePtr = ModuleRegistry::ModulePtr;
+    registry.applyToModuleIf(
+        [](ModulePtr module) { return module->getName().find("foo") == 0; },
+        [](ModulePtr module) { module->setLevel(6); });
+    CHECK_EQ(module1->getLevel(), 6);
+    CHECK_EQ(module2->getLevel(), 1);
+}
+
+TEST_CASE("clear: ModuleHandle of a removed module should stay usable")
+{
+    ModuleRegistry registry;
+    auto module1 = registry.useOrCreateModule("foo.1");
+    module1->setLevel(3);
+    registry.clear();
+    CHECK_EQ(registry.size(), 0);
+    CHECK_FALSE(registry.hasModule("foo.1"));
+
+    // -- RETIRED MODULE: Is still alive (as for a static ModuleHandle).
+    module1->log();
+    CHECK_EQ(module1->getName(), "foo.1");
+    CHECK_EQ(module1->getLevel(), 3);
+    CHECK_EQ(module1->getCounter(), 1);
+
+    // -- NEW MODULE: Is a different module (with its own slot).
+    auto module2 = registry.useOrCreateModule("foo.1");
+    CHECK(module2 != module1);
+    CHECK_EQ(module2->getCounter(), 0);
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
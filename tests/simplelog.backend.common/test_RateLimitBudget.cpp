@@ -0,0 +1,67 @@
+/**
+ * @file tests/simplelog.backend.common/test_RateLimitBudget.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/backend/common/RateLimitBudget.hpp"
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using simplelog::backend_common::RateLimitBudget;
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_common.RateLimitBudget");
+TEST_CASE("RateLimitBudget: Should drop log-records over the burst")
+{
+    simplelog::backend_common::setRateLimit(std::chrono::hours(1), 2);
+    RateLimitBudget budget;
+    std::uint64_t droppedCount = 0;
+    CHECK(budget.tryAcquire(droppedCount));
+    CHECK(budget.tryAcquire(droppedCount));
+    CHECK_FALSE(budget.tryAcquire(droppedCount));
+    CHECK_FALSE(budget.tryAcquire(droppedCount));
+    CHECK_EQ(droppedCount, 0);
+    CHECK_EQ(budget.getDroppedCount(), 2);
+    simplelog::backend_common::disableRateLimit();
+}
+
+TEST_CASE("RateLimitBudget: Should report the dropped log-records in the next interval")
+{
+    simplelog::backend_common::setRateLimit(std::chrono::milliseconds(20), 1);
+    RateLimitBudget budget;
+    std::uint64_t droppedCount = 0;
+    CHECK(budget.tryAcquire(droppedCount));
+    CHECK_FALSE(budget.tryAcquire(droppedCount));
+    CHECK_FALSE(budget.tryAcquire(droppedCount));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    CHECK(budget.tryAcquire(droppedCount));
+    CHECK_EQ(droppedCount, 2);
+    CHECK_EQ(budget.getDroppedCount(), 2);
+    simplelog::backend_common::disableRateLimit();
+}
+
+TEST_CASE("setRateLimit: Should enable and disable the rate limit")
+{
+    CHECK_FALSE(simplelog::backend_common::isRateLimitEnabled());
+    simplelog::backend_common::setRateLimit(std::chrono::seconds(30), 10000);
+    CHECK(simplelog::backend_common::isRateLimitEnabled());
+    simplelog::backend_common::disableRateLimit();
+    CHECK_FALSE(simplelog::backend_common::isRateLimitEnabled());
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
@@ -0,0 +1,71 @@
+/**
+ * @file tests/simplelog.backend.common/test_ThreadLevelOverride.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/backend/common/ThreadLevelOverride.hpp"
+#include <thread>
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using simplelog::backend_common::ThreadLevelOverrideScope;
+using simplelog::backend_common::findThreadLevelOverride;
+using simplelog::backend_common::hasThreadLevelOverrides;
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_common.ThreadLevelOverride");
+TEST_CASE("ThreadLevelOverrideScope: Should override level of matching modules in scope")
+{
+    int level = -1;
+    CHECK_FALSE(hasThreadLevelOverrides());
+    CHECK_FALSE(findThreadLevelOverride("db.query", level));
+    {
+        ThreadLevelOverrideScope scope("db.*", 7);
+        CHECK(hasThreadLevelOverrides());
+        CHECK(findThreadLevelOverride("db.query", level));
+        CHECK_EQ(level, 7);
+        CHECK_FALSE(findThreadLevelOverride("http", level));
+    }
+    CHECK_FALSE(hasThreadLevelOverrides());
+    CHECK_FALSE(findThreadLevelOverride("db.query", level));
+}
+
+TEST_CASE("ThreadLevelOverrideScope: Innermost scope should win")
+{
+    int level = -1;
+    ThreadLevelOverrideScope outerScope("*", 6);
+    {
+        ThreadLevelOverrideScope innerScope("db.*", 7);
+        CHECK(findThreadLevelOverride("db.query", level));
+        CHECK_EQ(level, 7);
+        CHECK(findThreadLevelOverride("http", level));
+        CHECK_EQ(level, 6);
+    }
+    CHECK(findThreadLevelOverride("db.query", level));
+    CHECK_EQ(level, 6);
+}
+
+TEST_CASE("ThreadLevelOverrideScope: Should not affect other threads")
+{
+    ThreadLevelOverrideScope scope("*", 7);
+    bool otherThreadHasOverrides = true;
+    std::thread otherThread([&]() {
+        otherThreadHasOverrides = hasThreadLevelOverrides();
+    });
+    otherThread.join();
+    CHECK(hasThreadLevelOverrides());
+    CHECK_FALSE(otherThreadHasOverrides);
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
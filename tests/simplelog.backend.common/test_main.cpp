@@ -0,0 +1,11 @@
+/**
+ * @file tests/simplelog.backend.common/test_main.cpp
+ * Unit tests main-function by using the doctest C++ testing framework.
+ *
+ * @see https://github.com/onqtam/doctest
+ * @see https://github.com/onqtam/doctest/blob/master/doc/markdown/tutorial.md
+ **/
+
+// -- TEST MAIN:
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
@@ -5,13 +5,17 @@
  **/
 
 // -- MORE-INCLUDES:
+#include "simplelog/backend/spdlog/ModuleUtil.hpp"
+#include "simplelog/backend/spdlog/SharedSinkSet.hpp"
 #include <spdlog/spdlog.h>
 
 namespace tests { namespace simplelog { namespace backend_spdlog {
 
 inline void cleanupLogging(void)
 {
-    ::spdlog::drop_all();
+    ::simplelog::backend_spdlog::dropAllLoggers();   //< SAME AS: spdlog::drop_all()
+    ::simplelog::backend_spdlog::getSharedSinkSet()->setSinks({});
+    ::simplelog::backend_spdlog::getLevelConfigRules().clear();
     // AVOID: ::spdlog::shutdown();
 }
 
@@ -0,0 +1,119 @@
+/**
+ * @file tests/simplelog.backend.spdlog/test_CachedPrefixFormatter.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/backend/spdlog/CachedPrefixFormatter.hpp"
+#include "simplelog/backend/spdlog/ModuleUtil.hpp"
+#include "simplelog/backend/spdlog/SetupUtil.hpp"
+#include <spdlog/spdlog.h>
+#include <spdlog/pattern_formatter.h>
+#include <spdlog/sinks/ostream_sink.h>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <utility>
+
+// -- LOCAL-INCLUDES:
+#include "CleanupLoggingFixture.hpp"
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using tests::simplelog::backend_spdlog::CleanupLoggingFixture;
+using simplelog::backend_spdlog::CachedPrefixFormatter;
+
+std::string formatWith(::spdlog::formatter& formatter, const ::spdlog::details::log_msg& msg)
+{
+    ::spdlog::memory_buf_t buffer;
+    formatter.format(msg, buffer);
+    return std::string(buffer.data(), buffer.size());
+}
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_spdlog::CachedPrefixFormatter");
+TEST_CASE("CachedPrefixFormatter: Should render the same output as the pattern_formatter")
+{
+    using std::chrono::milliseconds;
+    using ::spdlog::details::log_msg;
+    ::spdlog::pattern_formatter expectedFormatter("%+");
+    CachedPrefixFormatter formatter;
+    const auto time1 = ::spdlog::log_clock::now();
+    const ::spdlog::source_loc location{"src/foo/bar.cpp", 42, "func"};
+    const log_msg messages[] = {
+        log_msg(time1, {}, "foo", ::spdlog::level::info, "Message_1"),
+        log_msg(time1 + milliseconds(7), {}, "foo", ::spdlog::level::info, "Message_2"),
+        log_msg(time1 + milliseconds(1250), {}, "foo", ::spdlog::level::warn, "Message_3"),
+        log_msg(time1 + milliseconds(1999), {}, "bar", ::spdlog::level::warn, "Message_4"),
+        log_msg(time1 + milliseconds(61001), {}, "", ::spdlog::level::err, "Message_5"),
+        log_msg(time1 + milliseconds(61002), location, "foo", ::spdlog::level::err, "Message_6"),
+    };
+    for (const auto& msg : messages) {
+        CHECK_EQ(formatWith(formatter, msg), formatWith(expectedFormatter, msg));
+    }
+}
+
+TEST_CASE("CachedPrefixFormatter: Should mark the level name as color range")
+{
+    using ::spdlog::details::log_msg;
+    ::spdlog::pattern_formatter expectedFormatter("%+");
+    CachedPrefixFormatter formatter;
+    const log_msg msg(::spdlog::log_clock::now(), {}, "foo", ::spdlog::level::warn, "Message_1");
+    const auto text = formatWith(formatter, msg);
+    const auto colorRange = std::make_pair(msg.color_range_start, msg.color_range_end);
+    formatWith(expectedFormatter, msg);
+    CHECK_EQ(colorRange.first, msg.color_range_start);
+    CHECK_EQ(colorRange.second, msg.color_range_end);
+    CHECK_EQ(text.substr(colorRange.first, colorRange.second - colorRange.first), "warning");
+}
+
+TEST_CASE("makeCachedPrefixFormatter: Should use the pattern_formatter for other patterns")
+{
+    using ::spdlog::details::log_msg;
+    auto formatter = simplelog::backend_spdlog::makeCachedPrefixFormatter("%n: %v");
+    const log_msg msg(::spdlog::log_clock::now(), {}, "foo", ::spdlog::level::warn, "Message_1");
+    CHECK_EQ(formatWith(*formatter, msg), "foo: Message_1\n");
+    CHECK(dynamic_cast<CachedPrefixFormatter*>(formatter.get()) == nullptr);
+}
+
+TEST_CASE("setCachedPrefixFormatter: Should be used by all loggers")
+{
+    CleanupLoggingFixture cleanupGuard;
+    std::ostringstream output;
+    auto sink = std::make_shared<::spdlog::sinks::ostream_sink_st>(output);
+    simplelog::backend_spdlog::assignSink(sink);
+    simplelog::backend_spdlog::setCachedPrefixFormatter(::spdlog::pattern_time_type::utc);
+
+    auto log = simplelog::backend_spdlog::useOrCreateLogger("foo");
+    log->warn("Message_1");
+    const auto text = output.str();
+    REQUIRE_EQ(text.size(), 26 + std::string("[foo] [warning] Message_1\n").size());
+    CHECK_EQ(text.substr(26), "[foo] [warning] Message_1\n");
+    CHECK_EQ(text.substr(0, 1), "[");
+    CHECK_EQ(text.substr(24, 2), "] ");
+}
+
+TEST_CASE("setCachedPrefixFormatter: Should keep a user pattern")
+{
+    CleanupLoggingFixture cleanupGuard;
+    std::ostringstream output;
+    auto sink = std::make_shared<::spdlog::sinks::ostream_sink_st>(output);
+    simplelog::backend_spdlog::assignSink(sink);
+    simplelog::backend_spdlog::setCachedPrefixFormatter("%l: %v");
+
+    auto log = simplelog::backend_spdlog::useOrCreateLogger("foo");
+    log->warn("Message_1");
+    CHECK_EQ(output.str(), "warning: Message_1\n");
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
@@ -0,0 +1,104 @@
+/**
+ * @file tests/simplelog.backend.spdlog/test_ControlCommands.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/LogMacros.hpp"
+#include "simplelog/backend/spdlog/ControlCommands.hpp"
+#include "simplelog/backend/spdlog/ModuleUtil.hpp"
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/null_sink.h>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+// -- LOCAL-INCLUDES:
+#include "CleanupLoggingFixture.hpp"
+
+namespace {
+
+using tests::simplelog::backend_spdlog::CleanupLoggingFixture;
+using simplelog::backend_spdlog::ControlServer;
+using simplelog::backend_spdlog::useOrCreateLogger;
+using NullSink = ::spdlog::sinks::null_sink_mt;
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_spdlog::ControlCommands");
+TEST_CASE("set: Should assign level (and sinks) to matching loggers")
+{
+    CleanupLoggingFixture cleanupGuard;
+    auto sink1 = std::make_shared<NullSink>();
+    auto logger1 = useOrCreateLogger("foo.1");
+    auto logger2 = useOrCreateLogger("bar.1");
+    logger1->set_level(SIMPLELOG_BACKEND_LEVEL_WARN);
+    logger2->set_level(SIMPLELOG_BACKEND_LEVEL_WARN);
+
+    simplelog::backend_spdlog::useSharedSinkSet();
+    const auto SINKS1 = logger1->sinks();
+
+    ControlServer server("UNUSED");
+    simplelog::backend_spdlog::addControlCommands(server, {{"sink1", sink1}});
+    CHECK_EQ(server.execute("set foo.* debug sink1"), "OK\n");
+    CHECK_EQ(logger1->level(), SIMPLELOG_BACKEND_LEVEL_DEBUG);
+    CHECK_EQ(logger2->level(), SIMPLELOG_BACKEND_LEVEL_WARN);
+    using simplelog::backend_spdlog::getSharedSinkSet;
+    CHECK_EQ(logger1->sinks(), SINKS1);     //< UNCHANGED: Only the snapshot is swapped.
+    const auto sinks = getSharedSinkSet()->getSinks("foo.1");
+    REQUIRE_EQ(sinks.size(), 1);
+    CHECK_EQ(sinks.front(), sink1);
+
+    // -- CASE: Bad command usage.
+    CHECK_EQ(server.execute("set foo.* UNKNOWN"), "ERROR: Unknown level: UNKNOWN\n");
+    CHECK_EQ(server.execute("set foo.*").rfind("ERROR:", 0), 0);
+    CHECK_EQ(server.execute("set foo.* info UNKNOWN_SINK"), "ERROR: Unknown sink: UNKNOWN_SINK\n");
+    CHECK_EQ(logger1->level(), SIMPLELOG_BACKEND_LEVEL_DEBUG);
+
+    // -- CASE: Logger that is created later uses the level of the set command.
+    auto logger3 = useOrCreateLogger("foo.3");
+    CHECK_EQ(logger3->level(), SIMPLELOG_BACKEND_LEVEL_DEBUG);
+}
+
+TEST_CASE("list: Should show loggers with their level and counter (via socket)")
+{
+    CleanupLoggingFixture cleanupGuard;
+    simplelog::backend_spdlog::assignSink(std::make_shared<NullSink>());
+    auto logger1 = useOrCreateLogger("foo.1");
+    logger1->set_level(SIMPLELOG_BACKEND_LEVEL_ERROR);
+    logger1->error("Message_1");
+    logger1->error("Message_2");
+    logger1->info("DISABLED: Not counted");
+
+    char directory[] = "/tmp/test_simplelog.XXXXXX";
+    REQUIRE(::mkdtemp(directory) != nullptr);
+    const std::string socketPath = std::string(directory) + "/control.sock";
+    ControlServer server(socketPath);
+    simplelog::backend_spdlog::addControlCommands(server);
+    REQUIRE(server.start());
+
+    using simplelog::backend_common::sendControlCommand;
+    const auto response = sendControlCommand(socketPath, "list");
+    CHECK_NE(response.find("foo.1 error 2\n"), std::string::npos);
+    CHECK_EQ(sendControlCommand(socketPath, "flush"), "OK\n");
+    server.stop();
+    ::rmdir(directory);
+}
+
+TEST_CASE("dump: Should fail without DEFAULT_LOGGER (after drop_all)")
+{
+    CleanupLoggingFixture cleanupGuard;     //< SAME AS: spdlog::drop_all()
+    REQUIRE_FALSE(::spdlog::default_logger());
+
+    ControlServer server("UNUSED");
+    simplelog::backend_spdlog::addControlCommands(server);
+    CHECK_EQ(server.execute("dump").rfind("ERROR:", 0), 0);
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
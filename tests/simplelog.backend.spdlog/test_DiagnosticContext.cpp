@@ -0,0 +1,83 @@
+/**
+ * @file tests/simplelog.backend.spdlog/test_DiagnosticContext.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/LogMacros.hpp"
+#include "simplelog/backend/spdlog/DiagnosticContext.hpp"
+#include "simplelog/backend/spdlog/ModuleUtil.hpp"
+#include "simplelog/backend/spdlog/SetupUtil.hpp"
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/sinks/ostream_sink.h>
+#include <sstream>
+
+// -- LOCAL-INCLUDES:
+#include "CleanupLoggingFixture.hpp"
+
+namespace {
+
+using tests::simplelog::backend_spdlog::CleanupLoggingFixture;
+using simplelog::backend_spdlog::DiagnosticContextScope;
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_spdlog::DiagnosticContext");
+TEST_CASE("setPatternWithDiagnosticContext: Should add context prefix to log-records")
+{
+    CleanupLoggingFixture cleanupGuard;
+    std::ostringstream output;
+    auto sink = std::make_shared<::spdlog::sinks::ostream_sink_st>(output);
+    simplelog::backend_spdlog::assignSink(sink);
+    REQUIRE(simplelog::backend_spdlog::setPatternWithDiagnosticContext("%n: %*%v"));
+
+    SIMPLELOG_DEFINE_MODULE(log1, "foo");
+    log1->set_level(SIMPLELOG_BACKEND_LEVEL_INFO);
+    SIMPLELOGM_INFO(log1, "Message_1");
+    {
+        DiagnosticContextScope scope1("request", "42");
+        SIMPLELOGM_INFO(log1, "Message_{0}", 2);
+        SIMPLELOG_DEFINE_MODULE(log2, "bar");   //< NEW LOGGER: Inherits formatter.
+        SIMPLELOGM_WARN(log2, "Message_3");
+    }
+    SIMPLELOGM_INFO(log1, "Message_4");
+
+    CHECK_EQ(output.str(),
+        "foo: Message_1\n"
+        "foo: [request=42] Message_2\n"
+        "bar: [request=42] Message_3\n"
+        "foo: Message_4\n");
+    ::spdlog::set_pattern("%+");    //< CLEANUP: Formatter of the registry.
+}
+
+TEST_CASE("setPatternWithDiagnosticContext: Should be rejected in async mode (and vice versa)")
+{
+    using simplelog::backend_spdlog::DiagnosticContextFlag;
+    CleanupLoggingFixture cleanupGuard;
+    simplelog::backend_spdlog::assignSink(std::make_shared<::spdlog::sinks::null_sink_mt>());
+    REQUIRE_FALSE(DiagnosticContextFlag::isUsed());
+
+    // -- CASE: Async mode first.
+    REQUIRE(simplelog::backend_spdlog::setupAsync(64, 1));
+    CHECK_FALSE(simplelog::backend_spdlog::setPatternWithDiagnosticContext("%*%v"));
+    CHECK_FALSE(DiagnosticContextFlag::isUsed());
+    simplelog::backend_spdlog::shutdownAsync();
+
+    // -- CASE: Pattern first.
+    CleanupLoggingFixture cleanupGuard2;
+    simplelog::backend_spdlog::assignSink(std::make_shared<::spdlog::sinks::null_sink_mt>());
+    REQUIRE(simplelog::backend_spdlog::setPatternWithDiagnosticContext("%*%v"));
+    CHECK(DiagnosticContextFlag::isUsed());
+    CHECK_FALSE(simplelog::backend_spdlog::setupAsync(64, 1));
+    CHECK_FALSE(::spdlog::thread_pool());
+    ::spdlog::set_pattern("%+");    //< CLEANUP: Formatter of the registry.
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
@@ -0,0 +1,116 @@
+/**
+ * @file tests/simplelog.backend.spdlog/test_FlightRecorder.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/LogMacros.hpp"
+#include "simplelog/backend/spdlog/FlightRecorder.hpp"
+#include "simplelog/backend/spdlog/ModuleUtil.hpp"
+#include "simplelog/backend/spdlog/SetupUtil.hpp"
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/ostream_sink.h>
+#include <sstream>
+#include <string>
+
+// -- LOCAL-INCLUDES:
+#include "CleanupLoggingFixture.hpp"
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using tests::simplelog::backend_spdlog::CleanupLoggingFixture;
+
+//! Enables the flight recorder (and discards records of earlier tests).
+struct FlightRecorderGuard
+{
+    FlightRecorderGuard()
+    {
+        simplelog::backend_common::dumpFlightRecorder([](const auto&, const auto&) {});
+        simplelog::backend_spdlog::enableFlightRecorder(true);
+    }
+    ~FlightRecorderGuard()
+    {
+        simplelog::backend_spdlog::enableFlightRecorder(false);
+        simplelog::backend_common::dumpFlightRecorder([](const auto&, const auto&) {});
+    }
+};
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_spdlog::FlightRecorder");
+TEST_CASE("FlightRecorder: Should dump disabled log-records before an ERROR")
+{
+    CleanupLoggingFixture cleanupGuard;
+    FlightRecorderGuard flightRecorderGuard;
+    std::ostringstream output;
+    auto sink = std::make_shared<::spdlog::sinks::ostream_sink_st>(output);
+    sink->set_pattern("%n:%l:%v");
+    simplelog::backend_spdlog::assignSink(sink);
+
+    SIMPLELOG_DEFINE_MODULE(log1, "foo");
+    SIMPLELOG_DEFINE_MODULE(log2, "bar");
+    log1->set_level(SIMPLELOG_BACKEND_LEVEL_WARN);
+    log2->set_level(SIMPLELOG_BACKEND_LEVEL_WARN);
+    SIMPLELOGM_DEBUG(log1, "Message_1");
+    SIMPLELOGM_INFO(log2, "Message_{0}_{1}", 2, std::string("Alice"));
+    SIMPLELOGM_WARN(log1, "Message_3");     //< ENABLED: Does not dump.
+    CHECK_EQ(output.str(), "foo:warning:Message_3\n");
+
+    SIMPLELOGM_ERROR(log1, "Message_4");
+    SIMPLELOGM_ERROR(log1, "Message_5");    //< NOTHING TO DUMP.
+    CHECK_EQ(output.str(),
+        "foo:warning:Message_3\n"
+        "foo:debug:Message_1\n"
+        "bar:info:Message_2_Alice\n"
+        "foo:error:Message_4\n"
+        "foo:error:Message_5\n");
+}
+
+TEST_CASE("FlightRecorder: Should not capture log-records if disabled")
+{
+    CleanupLoggingFixture cleanupGuard;
+    std::ostringstream output;
+    auto sink = std::make_shared<::spdlog::sinks::ostream_sink_st>(output);
+    sink->set_pattern("%n:%v");
+    simplelog::backend_spdlog::assignSink(sink);
+
+    SIMPLELOG_DEFINE_MODULE(log1, "foo");
+    log1->set_level(SIMPLELOG_BACKEND_LEVEL_WARN);
+    SIMPLELOGM_DEBUG(log1, "Message_1");
+    SIMPLELOGM_ERROR(log1, "Message_2");
+    CHECK_EQ(output.str(), "foo:Message_2\n");
+}
+
+TEST_CASE("FlightRecorder: Should dump each log-record to the sinks of its logger")
+{
+    CleanupLoggingFixture cleanupGuard;
+    FlightRecorderGuard flightRecorderGuard;
+    std::ostringstream output1;
+    std::ostringstream output2;
+    auto sink1 = std::make_shared<::spdlog::sinks::ostream_sink_st>(output1);
+    auto sink2 = std::make_shared<::spdlog::sinks::ostream_sink_st>(output2);
+    sink1->set_pattern("%n:%v");
+    sink2->set_pattern("%n:%v");
+
+    SIMPLELOG_DEFINE_MODULE(log1, "foo");
+    SIMPLELOG_DEFINE_MODULE(log2, "bar");
+    log1->sinks().assign({sink1});
+    log2->sinks().assign({sink2});
+    log1->set_level(SIMPLELOG_BACKEND_LEVEL_WARN);
+    log2->set_level(SIMPLELOG_BACKEND_LEVEL_WARN);
+    SIMPLELOGM_DEBUG(log1, "Message_1");
+    SIMPLELOGM_ERROR(log2, "Message_2");
+    CHECK_EQ(output1.str(), "foo:Message_1\n");
+    CHECK_EQ(output2.str(), "bar:Message_2\n");
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
@@ -0,0 +1,128 @@
+/**
+ * @file tests/simplelog.backend.spdlog/test_FormatOnceSink.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/backend/spdlog/FormatOnceSink.hpp"
+#include "simplelog/backend/spdlog/ModuleUtil.hpp"
+#include "simplelog/backend/spdlog/SetupUtil.hpp"
+#include <spdlog/spdlog.h>
+#include <spdlog/pattern_formatter.h>
+#include <memory>
+#include <sstream>
+#include <string>
+
+// -- LOCAL-INCLUDES:
+#include "CleanupLoggingFixture.hpp"
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using tests::simplelog::backend_spdlog::CleanupLoggingFixture;
+using simplelog::backend_spdlog::OstreamWriter;
+using simplelog::backend_spdlog::SyslogWriter;
+using simplelog::backend_spdlog::makeFormatOnceSink;
+
+class CountingFormatter : public ::spdlog::formatter
+{
+public:
+    std::string m_pattern;
+    std::unique_ptr<::spdlog::formatter> m_formatter;
+    int& m_counter;
+
+    CountingFormatter(const std::string& pattern, int& counter)
+        : m_pattern(pattern),
+          m_formatter(std::make_unique<::spdlog::pattern_formatter>(pattern)),
+          m_counter(counter)
+    {}
+
+    void format(const ::spdlog::details::log_msg& msg, ::spdlog::memory_buf_t& dest) override
+    {
+        ++m_counter;
+        m_formatter->format(msg, dest);
+    }
+
+    std::unique_ptr<::spdlog::formatter> clone() const override
+    {
+        return std::make_unique<CountingFormatter>(m_pattern, m_counter);
+    }
+};
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_spdlog::FormatOnceSink");
+TEST_CASE("FormatOnceSink: Should write the same formatted log-record to all writers")
+{
+    CleanupLoggingFixture cleanupGuard;
+    std::ostringstream output1;
+    std::ostringstream output2;
+    auto sink = makeFormatOnceSink("%n::%l  %v", {
+        std::make_shared<OstreamWriter>(output1),
+        std::make_shared<OstreamWriter>(output2)
+    });
+    simplelog::backend_spdlog::assignSink(sink);
+
+    auto log = simplelog::backend_spdlog::useOrCreateLogger("foo");
+    log->warn("Message_{0}", 1);
+    log->error("Message_2");
+
+    const auto expected = "foo::warning  Message_1\nfoo::error  Message_2\n";
+    CHECK_EQ(output1.str(), expected);
+    CHECK_EQ(output2.str(), expected);
+}
+
+TEST_CASE("FormatOnceSink: Should format each log-record only once")
+{
+    CleanupLoggingFixture cleanupGuard;
+    std::ostringstream output1;
+    std::ostringstream output2;
+    std::ostringstream output3;
+    int formatCount = 0;
+    auto sink = makeFormatOnceSink("%v", {
+        std::make_shared<OstreamWriter>(output1),
+        std::make_shared<OstreamWriter>(output2)
+    });
+    sink->addWriter(std::make_shared<OstreamWriter>(output3));
+    sink->set_formatter(std::make_unique<CountingFormatter>("%n:%v", formatCount));
+
+    auto log = std::make_shared<::spdlog::logger>("foo", sink);
+    log->warn("Message_1");
+    log->warn("Message_2");
+
+    CHECK_EQ(formatCount, 2);
+    CHECK_EQ(sink->getWriters().size(), 3);
+    CHECK_EQ(output1.str(), "foo:Message_1\nfoo:Message_2\n");
+    CHECK_EQ(output3.str(), output1.str());
+}
+
+TEST_CASE("FormatOnceSink: Should clone the formatter with its pattern")
+{
+    int formatCount = 0;
+    const CountingFormatter formatter("%l:%v", formatCount);
+    auto clonedFormatter = formatter.clone();
+    ::spdlog::details::log_msg msg("foo", ::spdlog::level::warn, "Message_1");
+    ::spdlog::memory_buf_t formatted;
+    clonedFormatter->format(msg, formatted);
+    CHECK_EQ(std::string(formatted.data(), formatted.size()), "warning:Message_1\n");
+    CHECK_EQ(formatCount, 1);
+}
+
+TEST_CASE("SyslogWriter: Should map spdlog levels to syslog levels")
+{
+    CHECK_EQ(SyslogWriter::toSyslogLevel(::spdlog::level::trace), LOG_DEBUG);
+    CHECK_EQ(SyslogWriter::toSyslogLevel(::spdlog::level::info), LOG_INFO);
+    CHECK_EQ(SyslogWriter::toSyslogLevel(::spdlog::level::warn), LOG_WARNING);
+    CHECK_EQ(SyslogWriter::toSyslogLevel(::spdlog::level::err), LOG_ERR);
+    CHECK_EQ(SyslogWriter::toSyslogLevel(::spdlog::level::critical), LOG_CRIT);
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
@@ -93,6 +93,124 @@ TEST_CASE("useOrCreateLogger: Should return a known logger")
     CHECK_EQ(logger1, logger2);
 }
 
+TEST_CASE("useOrCreateLoggerHandle: Should return the registered logger (as raw pointer)")
+{
+    using simplelog::backend_spdlog::useOrCreateLoggerHandle;
+    CleanupLoggingFixture cleanupGuard;
+    require_logger_is_unknown("foo");
+    auto handle1 = useOrCreateLoggerHandle(SIMPLELOG_BACKEND_MODULE_NAME("foo"));
+    require_logger_is_known("foo");
+    CHECK_EQ(handle1, spdlog::get("foo").get());
+
+    // -- SAME NAME: Returns same logger (also via std::string).
+    auto handle2 = useOrCreateLoggerHandle(std::string("foo"));
+    CHECK_EQ(handle1, handle2);
+}
+
+TEST_CASE("useOrCreateLoggerHandle: Should use an existing logger")
+{
+    using simplelog::backend_spdlog::useOrCreateLogger;
+    using simplelog::backend_spdlog::useOrCreateLoggerHandle;
+    CleanupLoggingFixture cleanupGuard;
+    auto logger1 = useOrCreateLogger("foo.1");
+    auto handle1 = useOrCreateLoggerHandle("foo.1");
+    CHECK_EQ(handle1, logger1.get());
+}
+
+TEST_CASE("dropAllLoggers: Should drop loggers and unpin logger handles")
+{
+    using simplelog::backend_spdlog::useOrCreateLoggerHandle;
+    using simplelog::backend_spdlog::getLoggerHandleRegistry;
+    CleanupLoggingFixture cleanupGuard;
+    useOrCreateLoggerHandle("foo.1");
+    useOrCreateLoggerHandle("foo.2");
+    REQUIRE_EQ(getLoggerHandleRegistry().size(), 2);
+
+    simplelog::backend_spdlog::dropAllLoggers();
+    CHECK_EQ(getLoggerHandleRegistry().size(), 0);
+    require_logger_is_unknown("foo.1");
+}
+
+TEST_CASE("dropAllLoggers: LoggerHandle of a dropped logger should stay usable")
+{
+    using simplelog::backend_spdlog::useOrCreateLoggerHandle;
+    CleanupLoggingFixture cleanupGuard;
+    auto handle1 = useOrCreateLoggerHandle("foo.1");
+    handle1->set_level(spdlog::level::warn);
+
+    simplelog::backend_spdlog::dropAllLoggers();
+    require_logger_is_unknown("foo.1");
+
+    // -- RETIRED LOGGER: Is still alive (as for a static LoggerHandle).
+    CHECK_EQ(handle1->name(), "foo.1");
+    CHECK_EQ(handle1->level(), spdlog::level::warn);
+    handle1->warn("Logged with a retired logger");
+
+    auto handle2 = useOrCreateLoggerHandle("foo.1");
+    CHECK_NE(handle2, handle1);
+    CHECK_EQ(handle2, spdlog::get("foo.1").get());
+}
+
+TEST_CASE("useOrCreateCachedLogger: Should return cached logger until loggers are dropped")
+{
+    using simplelog::backend_spdlog::CachedLogger;
+    using simplelog::backend_spdlog::useOrCreateCachedLogger;
+    CleanupLoggingFixture cleanupGuard;
+    CachedLogger cache;
+    auto logger1 = useOrCreateCachedLogger(cache, "foo.1");
+    REQUIRE(logger1);
+    CHECK_EQ(logger1, spdlog::get("foo.1"));
+    CHECK_EQ(useOrCreateCachedLogger(cache, "foo.1"), logger1);
+
+    // -- CASE: Other name with same cache entry => Resolves other logger.
+    auto logger2 = useOrCreateCachedLogger(cache, "foo.2");
+    CHECK_EQ(logger2->name(), "foo.2");
+
+    // -- CASE: Dropped loggers => Cache is invalidated.
+    simplelog::backend_spdlog::dropLogger("foo.2");
+    CHECK_EQ(spdlog::get("foo.2"), nullptr);
+    auto logger3 = useOrCreateCachedLogger(cache, "foo.2");
+    CHECK_NE(logger3, logger2);
+    CHECK_EQ(logger3, spdlog::get("foo.2"));
+}
+
+TEST_CASE("SIMPLELOG_DEFINE_MODULE: Should use a new logger after dropAllLoggers()")
+{
+    CleanupLoggingFixture cleanupGuard;
+    const auto useModule = []() {
+        SIMPLELOG_DEFINE_MODULE(log1, "foo.cached");
+        return log1;
+    };
+    auto logger1 = useModule();
+    CHECK_EQ(useModule(), logger1);
+    CHECK_EQ(logger1, spdlog::get("foo.cached"));
+
+    simplelog::backend_spdlog::dropAllLoggers();
+    auto logger2 = useModule();
+    CHECK_NE(logger2, logger1);
+    CHECK_EQ(logger2, spdlog::get("foo.cached"));
+}
+
+TEST_CASE("SIMPLELOG_DEFINE_MODULE: Should use a new logger after spdlog::drop_all()")
+{
+    CleanupLoggingFixture cleanupGuard;
+    const auto useModule = []() {
+        SIMPLELOG_DEFINE_MODULE(log1, "foo.plain");
+        return log1;
+    };
+    auto logger1 = useModule();
+    CHECK_EQ(logger1, spdlog::get("foo.plain"));
+
+    // -- DEFAULT: No logger cache (plain spdlog API is used to drop loggers).
+    spdlog::drop_all();
+    auto logger2 = useModule();
+#if SIMPLELOG_BACKEND_SPDLOG__USE_LOGGER_CACHE || SIMPLELOG_BACKEND_SPDLOG__USE_LOGGER_HANDLE
+    CHECK_EQ(logger2, logger1);     //< STALE: Until dropAllLoggers() is used.
+#else
+    CHECK_NE(logger2, logger1);
+    CHECK_EQ(logger2, spdlog::get("foo.plain"));
+#endif
+}
 
 TEST_SUITE_END();
 } // < NAMESPACE-END.
@@ -0,0 +1,161 @@
+/**
+ * @file tests/simplelog.backend.spdlog/test_PreallocatedRotatingFileSink.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/backend/spdlog/PreallocatedRotatingFileSink.hpp"
+#include <spdlog/spdlog.h>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using simplelog::backend_spdlog::PreallocatedRotatingFileSinkMT;
+
+struct TempDirectory
+{
+    std::string path;
+
+    TempDirectory()
+    {
+        char pathTemplate[] = "/tmp/simplelog_test_XXXXXX";
+        path = ::mkdtemp(pathTemplate);
+    }
+    ~TempDirectory()
+    {
+        const std::string command = "rm -rf " + path;
+        if (std::system(command.c_str()) != 0) {
+            // -- IGNORE
+        }
+    }
+};
+
+bool fileExists(const std::string& filename)
+{
+    return ::access(filename.c_str(), F_OK) == 0;
+}
+
+//! Allocated disk space of a file (in bytes).
+std::size_t allocatedSize(const std::string& filename)
+{
+    struct stat status{};
+    return (::stat(filename.c_str(), &status) == 0) ? static_cast<std::size_t>(status.st_blocks) * 512 : 0;
+}
+
+std::string readFile(const std::string& filename)
+{
+    std::ifstream input(filename);
+    std::ostringstream text;
+    text << input.rdbuf();
+    return text.str();
+}
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_spdlog::PreallocatedRotatingFileSink");
+TEST_CASE("PreallocatedRotatingFileSink: Should write log-records to the segment file")
+{
+    TempDirectory directory;
+    const std::string filename = directory.path + "/app.log";
+    {
+        auto sink = std::make_shared<PreallocatedRotatingFileSinkMT>(filename, 1024, 3);
+        sink->set_pattern("%n:%v");
+        ::spdlog::logger log("foo", sink);
+        log.warn("Message_1");
+        log.warn("Message_2");
+        CHECK_EQ(sink->filename(), directory.path + "/app.1.log");
+        CHECK_EQ(readFile(directory.path + "/app.1.log"), "");  //< BUFFERED.
+        log.flush();
+        CHECK_EQ(readFile(directory.path + "/app.1.log"), "foo:Message_1\nfoo:Message_2\n");
+    }
+    CHECK_FALSE(fileExists(directory.path + "/app.2.log"));   //< PREPARED: Removed.
+}
+
+TEST_CASE("PreallocatedRotatingFileSink: Should release the preallocated tail on close")
+{
+    TempDirectory directory;
+    const std::string filename = directory.path + "/app.log";
+    const std::size_t maxSize = 4 * 1024 * 1024;
+    {
+        auto sink = std::make_shared<PreallocatedRotatingFileSinkMT>(filename, maxSize, 3);
+        ::spdlog::logger log("foo", sink);
+        log.warn("Message_1");
+    }
+    CHECK_LT(allocatedSize(directory.path + "/app.1.log"), maxSize / 4);
+}
+
+TEST_CASE("PreallocatedRotatingFileSink: Should rotate and keep only the last segment files")
+{
+    TempDirectory directory;
+    const std::string filename = directory.path + "/app.log";
+    {
+        // -- SEGMENT: Holds 2 log-records (with 10 bytes each).
+        auto sink = std::make_shared<PreallocatedRotatingFileSinkMT>(filename, 20, 2);
+        sink->set_pattern("%v");
+        ::spdlog::logger log("foo", sink);
+        for (int i = 0; i < 8; ++i) {
+            log.warn("Message_{}", i);
+        }
+        CHECK_EQ(sink->filename(), directory.path + "/app.4.log");
+    }
+    CHECK_FALSE(fileExists(directory.path + "/app.1.log"));
+    CHECK_FALSE(fileExists(directory.path + "/app.2.log"));
+    CHECK_EQ(readFile(directory.path + "/app.3.log"), "Message_4\nMessage_5\n");
+    CHECK_EQ(readFile(directory.path + "/app.4.log"), "Message_6\nMessage_7\n");
+}
+
+TEST_CASE("PreallocatedRotatingFileSink: Should continue after existing segment files on restart")
+{
+    TempDirectory directory;
+    const std::string filename = directory.path + "/app.log";
+    for (int run = 0; run < 2; ++run) {
+        // -- SEGMENT: Holds 2 log-records (with 10 bytes each).
+        auto sink = std::make_shared<PreallocatedRotatingFileSinkMT>(filename, 20, 3);
+        sink->set_pattern("%v");
+        ::spdlog::logger log("foo", sink);
+        for (int i = 0; i < 3; ++i) {
+            log.warn("Message_{}", (run * 3) + i);
+        }
+    }
+    CHECK_FALSE(fileExists(directory.path + "/app.1.log"));     //< REMOVED: Oldest.
+    CHECK_EQ(readFile(directory.path + "/app.2.log"), "Message_2\n");
+    CHECK_EQ(readFile(directory.path + "/app.3.log"), "Message_3\nMessage_4\n");
+    CHECK_EQ(readFile(directory.path + "/app.4.log"), "Message_5\n");
+}
+
+TEST_CASE("PreallocatedRotatingFileSink: Should remove too many existing segment files on startup")
+{
+    TempDirectory directory;
+    for (const char* name : {"app.1.log", "app.2.log", "app.5.log", "app.log", "app.x.log", "other.1.log"}) {
+        std::ofstream(directory.path + "/" + name) << "OLD\n";
+    }
+    {
+        PreallocatedRotatingFileSinkMT sink(directory.path + "/app.log", 20, 2);
+        CHECK_EQ(sink.filename(), directory.path + "/app.6.log");
+    }
+    CHECK_FALSE(fileExists(directory.path + "/app.1.log"));
+    CHECK_FALSE(fileExists(directory.path + "/app.2.log"));
+    CHECK_EQ(readFile(directory.path + "/app.5.log"), "OLD\n");
+    CHECK(fileExists(directory.path + "/app.6.log"));
+    // -- UNRELATED FILES: Are kept.
+    CHECK(fileExists(directory.path + "/app.log"));
+    CHECK(fileExists(directory.path + "/app.x.log"));
+    CHECK(fileExists(directory.path + "/other.1.log"));
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
@@ -14,6 +14,12 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/sink.h>
 #include <spdlog/sinks/null_sink.h>
+#include <spdlog/sinks/ostream_sink.h>
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 
 // -- LOCAL-INCLUDES:
@@ -48,6 +54,15 @@ void assert_loggerHasSameSink(LoggerPtr logger, SinkPtr sink)
     CHECK_EQ(logger->sinks().front(), sink);
 }
 
+//! Checks the sinks of a logger that uses the SharedSinkSet.
+void assert_loggerHasSharedSinks(LoggerPtr logger, const Sinks& sinks)
+{
+    using simplelog::backend_spdlog::getSharedSinkSet;
+    CHECK_NE(logger, nullptr);
+    CHECK_EQ(logger->sinks(), Sinks{ getSharedSinkSet() });
+    CHECK_EQ(getSharedSinkSet()->getSinks(logger->name()), sinks);
+}
+
 void assert_loggerHasSameSinks(LoggerPtr logger, const Sinks& sinks)
 {
     CHECK_NE(logger, nullptr);
@@ -314,6 +329,410 @@ TEST_CASE("assignSinkToAny: Should assign sink to any matching loggers")
 #endif
 }
 
+TEST_CASE("ConfigTransaction: Should apply all staged changes on commit")
+{
+    using simplelog::backend_spdlog::useOrCreateLogger;
+    using simplelog::backend_spdlog::ConfigTransaction;
+    CleanupLoggingFixture cleanupGuard;
+    auto sink1 = std::make_shared<NullSink>();
+    auto sink2 = std::make_shared<NullSink>();
+    auto logger1 = useOrCreateLogger("foo_1");
+    auto logger2 = useOrCreateLogger("bar_2");
+    logger1->set_level(SIMPLELOG_BACKEND_LEVEL_WARN);
+    logger2->set_level(SIMPLELOG_BACKEND_LEVEL_WARN);
+    simplelog::backend_spdlog::useSharedSinkSet();
+
+    // -- STAGE: Nothing is changed before commit().
+    const auto hasNameStartingWithFoo = [](LoggerPtr log) {
+        return log->name().find("foo") == 0;
+    };
+    ConfigTransaction transaction;
+    transaction.assignSink(sink1)
+        .assignSinkToAny(sink2, hasNameStartingWithFoo)
+        .setLevelToAny(SIMPLELOG_BACKEND_LEVEL_DEBUG, hasNameStartingWithFoo);
+    CHECK_EQ(transaction.size(), 3);
+    CHECK_EQ(logger1->level(), SIMPLELOG_BACKEND_LEVEL_WARN);
+    CHECK_NE(simplelog::backend_spdlog::getSharedSinkSet()->getSinks("foo_1"), Sinks{ sink2 });
+
+    // -- COMMIT: Loggers keep their sinks vector (only the snapshot is swapped).
+    transaction.commit();
+    assert_loggerHasSharedSinks(logger1, Sinks{ sink2 });
+    assert_loggerHasSharedSinks(logger2, Sinks{ sink1 });
+    CHECK_EQ(logger1->level(), SIMPLELOG_BACKEND_LEVEL_DEBUG);
+    CHECK_EQ(logger2->level(), SIMPLELOG_BACKEND_LEVEL_WARN);
+
+    // -- CASE: New logger uses the sinks that were assigned to all loggers.
+    auto logger3 = useOrCreateLogger("foo_3");
+    assert_loggerHasSharedSinks(logger3, Sinks{ sink1 });
+}
+
+TEST_CASE("ConfigTransaction: Should publish sinks of all loggers as one snapshot")
+{
+    using simplelog::backend_spdlog::useOrCreateLogger;
+    using simplelog::backend_spdlog::ConfigTransaction;
+    using simplelog::backend_spdlog::getSharedSinkSet;
+    CleanupLoggingFixture cleanupGuard;
+    std::ostringstream output1;
+    std::ostringstream output2;
+    auto sink1 = std::make_shared<::spdlog::sinks::ostream_sink_mt>(output1);
+    auto sink2 = std::make_shared<::spdlog::sinks::ostream_sink_mt>(output2);
+    sink1->set_pattern("%n:%v");
+    sink2->set_pattern("%n:%v");
+    simplelog::backend_spdlog::assignSharedSinks({ sink1 });
+    auto logger1 = useOrCreateLogger("foo.1");
+    auto logger2 = useOrCreateLogger("foo.2");
+    const auto SINKS1 = logger1->sinks();
+    const auto routes1 = getSharedSinkSet()->getRoutes();
+    logger1->warn("Message_1");
+
+    ConfigTransaction().assignSink(sink2).commit();
+    CHECK_EQ(logger1->sinks(), SINKS1);
+    CHECK_NE(getSharedSinkSet()->getRoutes(), routes1);
+    logger1->warn("Message_2");
+    logger2->warn("Message_3");
+    CHECK_EQ(output1.str(), "foo.1:Message_1\n");
+    CHECK_EQ(output2.str(), "foo.1:Message_2\nfoo.2:Message_3\n");
+}
+
+TEST_CASE("ConfigTransaction: Should apply staged changes in order")
+{
+    using simplelog::backend_spdlog::useOrCreateLogger;
+    using simplelog::backend_spdlog::ConfigTransaction;
+    CleanupLoggingFixture cleanupGuard;
+    auto logger1 = useOrCreateLogger("foo_1");
+    auto logger2 = useOrCreateLogger("foo_2");
+    logger1->set_level(SIMPLELOG_BACKEND_LEVEL_ERROR);
+    logger2->set_level(SIMPLELOG_BACKEND_LEVEL_ERROR);
+
+    const auto hasLoggerSameName = [](LoggerPtr log) {
+        return log->name() == "foo_1";
+    };
+    ConfigTransaction()
+        .setLevelToAny(SIMPLELOG_BACKEND_LEVEL_DEBUG, hasLoggerSameName)
+        .setMinLevel(SIMPLELOG_BACKEND_LEVEL_INFO)
+        .commit();
+    CHECK_EQ(logger1->level(), SIMPLELOG_BACKEND_LEVEL_INFO);
+    CHECK_EQ(logger2->level(), SIMPLELOG_BACKEND_LEVEL_ERROR);
+}
+
+TEST_CASE("ConfigTransaction: Empty transaction should change nothing")
+{
+    using simplelog::backend_spdlog::useOrCreateLogger;
+    using simplelog::backend_spdlog::ConfigTransaction;
+    CleanupLoggingFixture cleanupGuard;
+    auto logger = useOrCreateLogger("foo_1");
+    logger->set_level(SIMPLELOG_BACKEND_LEVEL_ERROR);
+    const auto SINKS = logger->sinks();
+
+    ConfigTransaction transaction;
+    CHECK(transaction.empty());
+    transaction.commit();
+    CHECK_EQ(logger->level(), SIMPLELOG_BACKEND_LEVEL_ERROR);
+    CHECK_EQ(logger->sinks(), SINKS);
+}
+
+TEST_CASE("applyLevelConfig: Should assign levels and sinks to matching loggers")
+{
+    using simplelog::backend_spdlog::useOrCreateLogger;
+    using simplelog::backend_common::LevelConfig;
+    CleanupLoggingFixture cleanupGuard;
+    auto sink1 = std::make_shared<NullSink>();
+    auto logger1 = useOrCreateLogger("foo.1");
+    auto logger2 = useOrCreateLogger("foo.2");
+    auto logger3 = useOrCreateLogger("bar");
+    simplelog::backend_spdlog::useSharedSinkSet();
+    const auto SINKS3 = simplelog::backend_spdlog::getSharedSinkSet()->getSinks("bar");
+
+    // -- ORDER: Later entries override earlier entries.
+    const LevelConfig config{
+        {"*",     "error",   {}},
+        {"foo.*", "debug",   {"sink1", "UNKNOWN_SINK"}},
+        {"foo.2", "warn",    {}},
+        {"bar",   "UNKNOWN_LEVEL", {"sink1"}}
+    };
+    simplelog::backend_spdlog::applyLevelConfig(config, {{"sink1", sink1}});
+    CHECK_EQ(logger1->level(), SIMPLELOG_BACKEND_LEVEL_DEBUG);
+    CHECK_EQ(logger2->level(), SIMPLELOG_BACKEND_LEVEL_WARN);
+    CHECK_EQ(logger3->level(), SIMPLELOG_BACKEND_LEVEL_ERROR);
+    assert_loggerHasSharedSinks(logger1, Sinks{ sink1 });
+    assert_loggerHasSharedSinks(logger2, Sinks{ sink1 });
+    assert_loggerHasSharedSinks(logger3, SINKS3);
+}
+
+TEST_CASE("applyLevelConfig: Should assign levels and sinks to loggers created later")
+{
+    using simplelog::backend_spdlog::useOrCreateLogger;
+    using simplelog::backend_common::LevelConfig;
+    CleanupLoggingFixture cleanupGuard;
+    auto sink1 = std::make_shared<NullSink>();
+    useOrCreateLogger("db.1");
+    simplelog::backend_spdlog::useSharedSinkSet();
+
+    const LevelConfig config{
+        {"*",    "warn",  {}},
+        {"db.*", "debug", {"sink1"}}
+    };
+    simplelog::backend_spdlog::applyLevelConfig(config, {{"sink1", sink1}});
+    auto newLogger1 = useOrCreateLogger("db.new");
+    auto newLogger2 = useOrCreateLogger("other");
+    CHECK_EQ(newLogger1->level(), SIMPLELOG_BACKEND_LEVEL_DEBUG);
+    CHECK_EQ(newLogger2->level(), SIMPLELOG_BACKEND_LEVEL_WARN);
+    assert_loggerHasSharedSinks(newLogger1, Sinks{ sink1 });
+
+    // -- CASE: Reloaded config replaces the previous one.
+    simplelog::backend_spdlog::applyLevelConfig({{"*", "err", {}}});
+    auto newLogger3 = useOrCreateLogger("db.new2");
+    CHECK_EQ(newLogger3->level(), SIMPLELOG_BACKEND_LEVEL_ERROR);
+}
+
+TEST_CASE("applyLevelConfig: Should assign sinks to existing loggers (without useSharedSinkSet)")
+{
+    using simplelog::backend_spdlog::useOrCreateLogger;
+    using simplelog::backend_common::LevelConfig;
+    CleanupLoggingFixture cleanupGuard;
+    std::ostringstream output;
+    auto sink1 = std::make_shared<::spdlog::sinks::ostream_sink_mt>(output);
+    sink1->set_pattern("%n:%v");
+    auto logger1 = useOrCreateLogger("db.1");
+    auto logger2 = useOrCreateLogger("other");
+    const auto SINKS2 = logger2->sinks();
+
+    simplelog::backend_spdlog::applyLevelConfig({{"db.*", "info", {"file"}}}, {{"file", sink1}});
+    auto newLogger = useOrCreateLogger("db.new");
+    assert_loggerHasSharedSinks(logger1, Sinks{ sink1 });
+    assert_loggerHasSharedSinks(logger2, SINKS2);
+    assert_loggerHasSharedSinks(newLogger, Sinks{ sink1 });
+    logger1->info("Message_1");
+    newLogger->info("Message_2");
+    CHECK_EQ(output.str(), "db.1:Message_1\ndb.new:Message_2\n");
+}
+
+TEST_CASE("parseLevel: Should accept the level names of the LevelConfig")
+{
+    using simplelog::backend_spdlog::parseLevel;
+    ::spdlog::level::level_enum level = ::spdlog::level::off;
+    CHECK(parseLevel("err", level));
+    CHECK_EQ(level, SIMPLELOG_BACKEND_LEVEL_ERROR);
+    CHECK(parseLevel("error", level));
+    CHECK_EQ(level, SIMPLELOG_BACKEND_LEVEL_ERROR);
+    CHECK(parseLevel("warning", level));
+    CHECK_EQ(level, SIMPLELOG_BACKEND_LEVEL_WARN);
+    CHECK(parseLevel("notice", level));
+    CHECK_EQ(level, SIMPLELOG_BACKEND_LEVEL_INFO);
+    CHECK_FALSE(parseLevel("UNKNOWN_LEVEL", level));
+}
+
+TEST_CASE("selectAndApply: Should apply function to matching loggers only")
+{
+    using simplelog::backend_spdlog::useOrCreateLogger;
+    CleanupLoggingFixture cleanupGuard;
+    auto logger1 = useOrCreateLogger("foo.1");
+    auto logger2 = useOrCreateLogger("bar.1");
+    logger1->set_level(SIMPLELOG_BACKEND_LEVEL_ERROR);
+    logger2->set_level(SIMPLELOG_BACKEND_LEVEL_ERROR);
+
+    // -- HINT: Loggers are passed by reference (use_count is unchanged).
+    // spdlog::apply_all() passes a copy to its std::function (+1).
+    const auto EXPECTED_USE_COUNT = logger1.use_count() + 1;
+    long useCountInFunc = 0;
+    int counter = 0;
+    simplelog::backend_spdlog::selectAndApply(
+        [](const LoggerPtr& log) { return log->name().find("foo") == 0; },
+        [&](const LoggerPtr& log) {
+            useCountInFunc = log.use_count();
+            log->set_level(SIMPLELOG_BACKEND_LEVEL_DEBUG);
+            ++counter;
+        });
+    CHECK_EQ(counter, 1);
+    CHECK_EQ(logger1->level(), SIMPLELOG_BACKEND_LEVEL_DEBUG);
+    CHECK_EQ(logger2->level(), SIMPLELOG_BACKEND_LEVEL_ERROR);
+    CHECK_EQ(useCountInFunc, EXPECTED_USE_COUNT);
+}
+
+TEST_CASE("setLevelToAny: Should pass loggers by reference to the predicate")
+{
+    using simplelog::backend_spdlog::useOrCreateLogger;
+    CleanupLoggingFixture cleanupGuard;
+    auto logger1 = useOrCreateLogger("foo.1");
+    logger1->set_level(SIMPLELOG_BACKEND_LEVEL_ERROR);
+
+    const auto EXPECTED_USE_COUNT = logger1.use_count() + 1;   //< +1: spdlog::apply_all()
+    long useCountInPredicate = 0;
+    simplelog::backend_spdlog::setLevelToAny(SIMPLELOG_BACKEND_LEVEL_DEBUG,
+        [&](const LoggerPtr& log) {
+            useCountInPredicate = log.use_count();
+            return log->name() == "foo.1";
+        });
+    CHECK_EQ(logger1->level(), SIMPLELOG_BACKEND_LEVEL_DEBUG);
+    CHECK_EQ(useCountInPredicate, EXPECTED_USE_COUNT);
+}
+
+TEST_CASE("selectLoggers: Should return matching loggers")
+{
+    using simplelog::backend_spdlog::useOrCreateLogger;
+    CleanupLoggingFixture cleanupGuard;
+    auto logger1 = useOrCreateLogger("foo.1");
+    auto logger2 = useOrCreateLogger("bar.1");
+    const auto selected = simplelog::backend_spdlog::selectLoggers(
+        [](const LoggerPtr& log) { return log->name() == "bar.1"; });
+    REQUIRE_EQ(selected.size(), 1);
+    CHECK_EQ(selected.front(), logger2);
+}
+
+TEST_CASE("setupAsync: Should replace existing and new loggers with async loggers")
+{
+    using simplelog::backend_spdlog::useOrCreateLogger;
+    using simplelog::backend_spdlog::isAsyncLogger;
+    CleanupLoggingFixture cleanupGuard;
+    auto sink1 = std::make_shared<NullSink>();
+    simplelog::backend_spdlog::assignSink(sink1);
+    auto logger1 = useOrCreateLogger("foo.1");
+    logger1->set_level(SIMPLELOG_BACKEND_LEVEL_ERROR);
+    REQUIRE_FALSE(isAsyncLogger(logger1));
+
+    REQUIRE(simplelog::backend_spdlog::setupAsync(1024, 1));
+    auto asyncLogger1 = useOrCreateLogger("foo.1");
+    CHECK(isAsyncLogger(asyncLogger1));
+    CHECK(isAsyncLogger(spdlog::default_logger()));
+    CHECK_EQ(asyncLogger1->level(), SIMPLELOG_BACKEND_LEVEL_ERROR);
+    assert_loggerHasSameSink(asyncLogger1, sink1);
+
+    // -- CASE: New logger is cloned from DEFAULT_LOGGER => async logger.
+    auto logger2 = useOrCreateLogger("foo.2");
+    CHECK(isAsyncLogger(logger2));
+    assert_loggerHasSameSink(logger2, sink1);
+    simplelog::backend_spdlog::shutdownAsync();
+}
+
+TEST_CASE("setupAsync: Should replace pinned loggers of LoggerHandle(s)")
+{
+    using simplelog::backend_spdlog::useOrCreateLoggerHandle;
+    CleanupLoggingFixture cleanupGuard;
+    simplelog::backend_spdlog::assignSink(std::make_shared<NullSink>());
+    auto handle1 = useOrCreateLoggerHandle("foo.1");
+    REQUIRE(dynamic_cast<::spdlog::async_logger*>(handle1) == nullptr);
+
+    REQUIRE(simplelog::backend_spdlog::setupAsync(1024, 1));
+    auto handle2 = useOrCreateLoggerHandle("foo.1");
+    CHECK(dynamic_cast<::spdlog::async_logger*>(handle2) != nullptr);
+    CHECK_EQ(handle2, spdlog::get("foo.1").get());
+    CHECK_EQ(handle1->name(), "foo.1");     //< RETIRED: Old handle stays usable.
+    simplelog::backend_spdlog::shutdownAsync();
+}
+
+TEST_CASE("setupAsync: Should reject a second call (without shutdownAsync)")
+{
+    CleanupLoggingFixture cleanupGuard;
+    simplelog::backend_spdlog::assignSink(std::make_shared<NullSink>());
+    REQUIRE(simplelog::backend_spdlog::setupAsync(1024, 1));
+    const auto threadPool = ::spdlog::thread_pool();
+    CHECK_FALSE(simplelog::backend_spdlog::setupAsync(64, 1));
+    CHECK_EQ(::spdlog::thread_pool(), threadPool);
+    simplelog::backend_spdlog::shutdownAsync();
+
+    // -- AFTER SHUTDOWN: Async mode can be set up again.
+    CHECK(simplelog::backend_spdlog::setupAsync(64, 1));
+    simplelog::backend_spdlog::shutdownAsync();
+}
+
+TEST_CASE("shutdownAsync: Should write all queued log-records in order")
+{
+    using simplelog::backend_spdlog::useOrCreateLogger;
+    CleanupLoggingFixture cleanupGuard;
+    std::ostringstream output;
+    auto sink = std::make_shared<::spdlog::sinks::ostream_sink_mt>(output);
+    sink->set_pattern("%v");
+    simplelog::backend_spdlog::assignSink(sink);
+    REQUIRE(simplelog::backend_spdlog::setupAsync(64, 1));
+
+    SIMPLELOG_DEFINE_MODULE(log1, "foo.1");
+    log1->set_level(SIMPLELOG_BACKEND_LEVEL_INFO);
+    const int MAX_RECORDS = 1000;
+    std::string expected;
+    for (int i = 0; i < MAX_RECORDS; ++i) {
+        SIMPLELOGM_INFO(log1, "record_{0}", i);
+        expected += "record_" + std::to_string(i) + "\n";
+    }
+
+    // -- DRAIN-ON-EXIT: All queued log-records are written (with policy=block).
+    simplelog::backend_spdlog::shutdownAsync();
+    CHECK_EQ(output.str(), expected);
+}
+
+TEST_CASE("assignSharedSinks: Should retarget all loggers by swapping the shared sinks")
+{
+    using simplelog::backend_spdlog::useOrCreateLogger;
+    using simplelog::backend_spdlog::getSharedSinkSet;
+    CleanupLoggingFixture cleanupGuard;
+    std::ostringstream output1;
+    std::ostringstream output2;
+    auto sink1 = std::make_shared<::spdlog::sinks::ostream_sink_st>(output1);
+    auto sink2 = std::make_shared<::spdlog::sinks::ostream_sink_st>(output2);
+    auto logger1 = useOrCreateLogger("foo.1");
+
+    // -- FIRST USE: All loggers use the shared sink set.
+    simplelog::backend_spdlog::assignSharedSinks({ sink1 });
+    auto logger2 = useOrCreateLogger("foo.2");
+    assert_loggerHasSameSink(logger1, getSharedSinkSet());
+    assert_loggerHasSameSink(logger2, getSharedSinkSet());
+    logger1->set_pattern("%n:%v");
+    logger1->warn("Message_1");
+    logger2->warn("Message_2");
+
+    // -- RETARGET: Loggers are not changed (only the shared sink set).
+    simplelog::backend_spdlog::assignSharedSinks({ sink2 });
+    assert_loggerHasSameSink(logger1, getSharedSinkSet());
+    sink2->set_pattern("%n:%v");
+    logger1->warn("Message_3");
+    logger2->warn("Message_4");
+
+    CHECK_EQ(output1.str(), "foo.1:Message_1\nfoo.2:Message_2\n");
+    CHECK_EQ(output2.str(), "foo.1:Message_3\nfoo.2:Message_4\n");
+}
+
+TEST_CASE("SharedSinkSet: Should forward each log-record while sinks are swapped")
+{
+    using simplelog::backend_spdlog::SharedSinkSet;
+    // -- HINT: Each swap releases the old sinks (after the grace period).
+    class CountingSink : public ::spdlog::sinks::sink
+    {
+    public:
+        std::atomic<int>& m_counter;
+        explicit CountingSink(std::atomic<int>& counter) : m_counter(counter) {}
+        void log(const ::spdlog::details::log_msg&) override { ++m_counter; }
+        void flush() override {}
+        void set_pattern(const std::string&) override {}
+        void set_formatter(std::unique_ptr<::spdlog::formatter>) override {}
+    };
+
+    std::atomic<int> counter(0);
+    auto sinkSet = std::make_shared<SharedSinkSet>(Sinks{ std::make_shared<CountingSink>(counter) });
+    auto logger = std::make_shared<::spdlog::logger>("foo.shared", sinkSet);
+    const int MAX_THREADS = 4;
+    const int MAX_RECORDS = 2000;
+    std::atomic<bool> done(false);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < MAX_THREADS; ++i) {
+        threads.emplace_back([&]() {
+            for (int record = 0; record < MAX_RECORDS; ++record) {
+                logger->warn("Message_{0}", record);
+            }
+        });
+    }
+    std::thread swapper([&]() {
+        while (!done.load()) {
+            sinkSet->setSinks(Sinks{ std::make_shared<CountingSink>(counter) });
+        }
+    });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    done = true;
+    swapper.join();
+    CHECK_EQ(counter.load(), MAX_THREADS * MAX_RECORDS);
+    CHECK_EQ(sinkSet->getSinks().size(), 1);
+}
+
 TEST_SUITE_END();
 } // < NAMESPACE-END.
 //< ENDOF(__TEST_SOURCE_FILE__)
@@ -0,0 +1,127 @@
+/**
+ * @file tests/simplelog.backend.spdlog/test_ThreadLevelOverride.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/LogMacros.hpp"
+#include "simplelog/backend/spdlog/ModuleUtil.hpp"
+#include "simplelog/backend/spdlog/SetupUtil.hpp"
+#include "simplelog/backend/spdlog/ThreadLevelOverride.hpp"
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/ostream_sink.h>
+#include <spdlog/details/null_mutex.h>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// -- LOCAL-INCLUDES:
+#include "CleanupLoggingFixture.hpp"
+
+namespace {
+
+using tests::simplelog::backend_spdlog::CleanupLoggingFixture;
+using simplelog::backend_spdlog::ThreadLevelOverrideScope;
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+/**
+ * Captures the log-records of all loggers (with pattern: "<name>:<message>").
+ **/
+struct CaptureLogRecords
+{
+    std::ostringstream output;
+
+    CaptureLogRecords()
+    {
+        auto sink = std::make_shared<::spdlog::sinks::ostream_sink_st>(output);
+        sink->set_pattern("%n:%v");
+        simplelog::backend_spdlog::assignSink(sink);
+    }
+    std::string text() const { return output.str(); }
+};
+
+//! Sink that fails to write each log-record.
+class FailingSink : public ::spdlog::sinks::base_sink<::spdlog::details::null_mutex>
+{
+protected:
+    void sink_it_(const ::spdlog::details::log_msg&) override
+    {
+        throw ::spdlog::spdlog_ex("FailingSink: write failed");
+    }
+    void flush_() override {}
+};
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_spdlog::ThreadLevelOverride");
+TEST_CASE("ThreadLevelOverrideScope: Should enable log-records of matching loggers")
+{
+    CleanupLoggingFixture cleanupGuard;
+    CaptureLogRecords capture;
+    SIMPLELOG_DEFINE_MODULE(log1, "db.query");
+    SIMPLELOG_DEFINE_MODULE(log2, "http");
+    log1->set_level(SIMPLELOG_BACKEND_LEVEL_WARN);
+    log2->set_level(SIMPLELOG_BACKEND_LEVEL_WARN);
+
+    SIMPLELOGM_DEBUG(log1, "DISABLED_1");
+    {
+        ThreadLevelOverrideScope scope("db.*", SIMPLELOG_BACKEND_LEVEL_DEBUG);
+        SIMPLELOGM_DEBUG(log1, "ENABLED_{0}", 1);
+        SIMPLELOGM_INFO(log1, "ENABLED_2");
+        SIMPLELOGM_DEBUG(log2, "DISABLED_2");
+        SIMPLELOGM_WARN(log2, "ENABLED_{0}", 3);
+    }
+    SIMPLELOGM_DEBUG(log1, "DISABLED_3");
+
+    CHECK_EQ(capture.text(), "db.query:ENABLED_1\ndb.query:ENABLED_2\nhttp:ENABLED_3\n");
+    CHECK_EQ(log1->level(), SIMPLELOG_BACKEND_LEVEL_WARN);
+}
+
+TEST_CASE("ThreadLevelOverrideScope: Should not enable log-records of other threads")
+{
+    CleanupLoggingFixture cleanupGuard;
+    CaptureLogRecords capture;
+    SIMPLELOG_DEFINE_MODULE(log1, "db.query");
+    log1->set_level(SIMPLELOG_BACKEND_LEVEL_WARN);
+
+    ThreadLevelOverrideScope scope("*", SIMPLELOG_BACKEND_LEVEL_DEBUG);
+    std::thread otherThread([&]() {
+        SIMPLELOGM_DEBUG(log1, "DISABLED_1");
+    });
+    otherThread.join();
+    SIMPLELOGM_DEBUG(log1, "ENABLED_1");
+    CHECK_EQ(capture.text(), "db.query:ENABLED_1\n");
+}
+
+TEST_CASE("ThreadLevelOverrideScope: Should log enabled log-records through the logger")
+{
+    CleanupLoggingFixture cleanupGuard;
+    CaptureLogRecords capture;
+    SIMPLELOG_DEFINE_MODULE(log1, "db.query");
+    log1->set_level(SIMPLELOG_BACKEND_LEVEL_WARN);
+    const auto initialCount = simplelog::backend_spdlog::getRecordCount(*log1);
+
+    ThreadLevelOverrideScope scope("db.*", SIMPLELOG_BACKEND_LEVEL_DEBUG);
+    SIMPLELOGM_DEBUG(log1, "ENABLED_1");
+    CHECK_EQ(simplelog::backend_spdlog::getRecordCount(*log1), initialCount + 1);
+
+    // -- CASE: A failing sink is reported to the error handler of the logger.
+    std::string errorMessage;
+    log1->sinks().assign({std::make_shared<FailingSink>()});
+    log1->set_error_handler([&errorMessage](const std::string& message) {
+        errorMessage = message;
+    });
+    CHECK_NOTHROW(SIMPLELOGM_DEBUG(log1, "ENABLED_2"));
+    CHECK_NE(errorMessage.find("FailingSink: write failed"), std::string::npos);
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
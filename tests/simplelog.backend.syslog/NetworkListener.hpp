@@ -0,0 +1,141 @@
+/**
+ * @file tests/simplelog.backend.syslog/NetworkListener.hpp
+ * Local syslog relay replacement (TCP or UDP on the loopback interface) for tests.
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <string>
+#include <string_view>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace tests { namespace simplelog { namespace backend_syslog {
+
+/**
+ * @class NetworkListener
+ * Receives the log-records that are sent to its port (on 127.0.0.1).
+ *
+ *   - UDP: One log-record per datagram.
+ *   - TCP: Octet-counted frames "LEN SP MSG" (of the accepted connection).
+ **/
+class NetworkListener
+{
+private:
+    bool m_isStream;
+    int m_port;
+    int m_fd;
+    int m_connectionFd;
+    std::string m_received;     //< TCP: Received, but not parsed data.
+
+public:
+    explicit NetworkListener(bool isStream)
+        : m_isStream(isStream), m_port(0), m_fd(-1), m_connectionFd(-1), m_received()
+    {
+        open();
+    }
+    ~NetworkListener()
+    {
+        close();
+    }
+
+    int getPort() const { return m_port; }
+    std::string getAddress() const
+    {
+        return std::string(m_isStream ? "tcp://" : "udp://") + "127.0.0.1:" + std::to_string(m_port);
+    }
+
+    //! Opens the socket (again: with the same port).
+    void open()
+    {
+        m_fd = ::socket(AF_INET, (m_isStream ? SOCK_STREAM : SOCK_DGRAM) | SOCK_CLOEXEC, 0);
+        const int enabled = 1;
+        ::setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(static_cast<uint16_t>(m_port));
+        ::bind(m_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        socklen_t size = sizeof(address);
+        ::getsockname(m_fd, reinterpret_cast<sockaddr*>(&address), &size);
+        m_port = ntohs(address.sin_port);
+        if (m_isStream) {
+            ::listen(m_fd, 4);
+        }
+    }
+
+    void close()
+    {
+        if (m_connectionFd >= 0) {
+            ::close(m_connectionFd);
+            m_connectionFd = -1;
+        }
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+        m_received.clear();
+    }
+
+    //! Receives the next log-record (or an empty string after the timeout).
+    std::string receive(int timeoutInMillis = 1000)
+    {
+        if (!m_isStream) {
+            return receiveData(m_fd, timeoutInMillis);
+        }
+        std::string record;
+        while (!parseFrame(record)) {
+            if ((m_connectionFd < 0) && !accept(timeoutInMillis)) {
+                return std::string();
+            }
+            const auto data = receiveData(m_connectionFd, timeoutInMillis);
+            if (data.empty()) {
+                return std::string();
+            }
+            m_received += data;
+        }
+        return record;
+    }
+
+private:
+    bool accept(int timeoutInMillis)
+    {
+        pollfd pollFd{m_fd, POLLIN, 0};
+        if (::poll(&pollFd, 1, timeoutInMillis) <= 0) {
+            return false;
+        }
+        m_connectionFd = ::accept4(m_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        return m_connectionFd >= 0;
+    }
+
+    static std::string receiveData(int fd, int timeoutInMillis)
+    {
+        pollfd pollFd{fd, POLLIN, 0};
+        if (::poll(&pollFd, 1, timeoutInMillis) <= 0) {
+            return std::string();
+        }
+        char buffer[4096];
+        const auto size = ::recv(fd, buffer, sizeof(buffer), 0);
+        return (size > 0) ? std::string(buffer, static_cast<std::size_t>(size)) : std::string();
+    }
+
+    bool parseFrame(std::string& record)
+    {
+        const auto space = m_received.find(' ');
+        if (space == std::string::npos) {
+            return false;
+        }
+        const auto size = std::stoul(m_received.substr(0, space));
+        if (m_received.size() < space + 1 + size) {
+            return false;
+        }
+        record = m_received.substr(space + 1, size);
+        m_received.erase(0, space + 1 + size);
+        return true;
+    }
+};
+
+}}} //< NAMESPACE-END: tests::simplelog::backend_syslog
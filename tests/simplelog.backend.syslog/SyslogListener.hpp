@@ -0,0 +1,98 @@
+/**
+ * @file tests/simplelog.backend.syslog/SyslogListener.hpp
+ * Local syslog daemon replacement (AF_UNIX datagram socket) for tests.
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace tests { namespace simplelog { namespace backend_syslog {
+
+/**
+ * @class SyslogListener
+ * Receives the datagrams that are sent to its socket path.
+ **/
+class SyslogListener
+{
+private:
+    std::string m_directory;
+    std::string m_path;
+    int m_fd;
+
+public:
+    SyslogListener() : m_directory(), m_path(), m_fd(-1)
+    {
+        char pathTemplate[] = "/tmp/simplelog_syslog_XXXXXX";
+        m_directory = ::mkdtemp(pathTemplate);
+        m_path = m_directory + "/log";
+        open();
+    }
+    ~SyslogListener()
+    {
+        close();
+        ::rmdir(m_directory.c_str());
+    }
+
+    const std::string& getPath() const { return m_path; }
+
+    void open()
+    {
+        m_fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, m_path.c_str(), sizeof(address.sun_path) - 1);
+        ::bind(m_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    }
+
+    void close()
+    {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            ::unlink(m_path.c_str());
+            m_fd = -1;
+        }
+    }
+
+    /**
+     * Fills the receive queue of the socket (as: a slow daemon).
+     * Afterwards, a blocking sender waits until the next receive().
+     * @return Number of sent filler datagrams (that must be received first).
+     **/
+    std::size_t fill()
+    {
+        const int fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, m_path.c_str(), sizeof(address.sun_path) - 1);
+        std::size_t count = 0;
+        if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0) {
+            while (::send(fd, "FILLER", 6, MSG_DONTWAIT) >= 0) {
+                ++count;
+            }
+        }
+        ::close(fd);
+        return count;
+    }
+
+    //! Receives the next datagram (or an empty string after the timeout).
+    std::string receive(int timeoutInMillis = 1000)
+    {
+        pollfd pollFd{m_fd, POLLIN, 0};
+        if (::poll(&pollFd, 1, timeoutInMillis) <= 0) {
+            return std::string();
+        }
+        char buffer[4096];
+        const auto size = ::recv(m_fd, buffer, sizeof(buffer), 0);
+        return (size > 0) ? std::string(buffer, static_cast<std::size_t>(size)) : std::string();
+    }
+};
+
+}}} //< NAMESPACE-END: tests::simplelog::backend_syslog
@@ -0,0 +1,164 @@
+/**
+ * @file tests/simplelog.backend.syslog/test_AsyncSender.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/backend/syslog/AsyncSender.hpp"
+#include "simplelog/backend/syslog/Module.hpp"
+#include "simplelog/backend/syslog/SetupUtil.hpp"
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+
+// -- LOCAL-INCLUDES:
+#include "SyslogListener.hpp"
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using tests::simplelog::backend_syslog::SyslogListener;
+using simplelog::backend_syslog::AsyncOverflowPolicy;
+using simplelog::backend_syslog::AsyncSender;
+using simplelog::backend_syslog::SyslogFormat;
+using simplelog::backend_syslog::SyslogTransport;
+
+std::string messageOf(const std::string& datagram)
+{
+    const auto pos = datagram.find("]: ");
+    return (pos == std::string::npos) ? datagram : datagram.substr(pos + 3);
+}
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_syslog.AsyncSender");
+TEST_CASE("AsyncSender: Should send all log-records in order")
+{
+    SyslogListener listener;
+    auto transport = std::make_shared<SyslogTransport>(listener.getPath(), SyslogFormat::RFC3164, "myapp");
+    AsyncSender sender(16, AsyncOverflowPolicy::Block, transport);
+    for (int i = 0; i < 5; ++i) {
+        CHECK(sender.enqueue(LOG_INFO, "Message_" + std::to_string(i)));
+    }
+    sender.flush();
+    CHECK_EQ(sender.getSentCount(), 5);
+    CHECK_EQ(sender.getDroppedCount(), 0);
+    for (int i = 0; i < 5; ++i) {
+        CHECK_EQ(messageOf(listener.receive()), "Message_" + std::to_string(i));
+    }
+}
+
+TEST_CASE("AsyncSender: Should count dropped log-records if the daemon is slow")
+{
+    // -- SLOW DAEMON: Receive queue is full. Sender thread blocks in send().
+    SyslogListener listener;
+    auto transport = std::make_shared<SyslogTransport>(listener.getPath(), SyslogFormat::RFC3164, "myapp");
+    const auto fillerCount = listener.fill();
+    REQUIRE(fillerCount > 0);
+    AsyncSender sender(4, AsyncOverflowPolicy::DropNewest, transport, 1);
+    CHECK(sender.enqueue(LOG_INFO, "Message_0"));
+    for (int i = 0; (i < 5000) && (sender.getQueuedCount() > 0); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE_EQ(sender.getQueuedCount(), 0);     //< TAKEN: Sender thread is blocked.
+
+    for (int i = 1; i <= 10; ++i) {
+        sender.enqueue(LOG_INFO, "Message_" + std::to_string(i));
+    }
+    CHECK_EQ(sender.getQueuedCount(), 4);
+    CHECK_EQ(sender.getDroppedCount(), 6);
+
+    // -- DAEMON CATCHES UP:
+    for (std::size_t i = 0; i < fillerCount; ++i) {
+        listener.receive();
+    }
+    sender.flush();
+    for (int i = 0; i <= 4; ++i) {
+        CHECK_EQ(messageOf(listener.receive()), "Message_" + std::to_string(i));
+    }
+    CHECK_EQ(sender.getSentCount(), 5);
+}
+
+TEST_CASE("AsyncSender: Should use the timestamp of the enqueue call")
+{
+    SyslogListener listener;
+    auto transport = std::make_shared<SyslogTransport>(listener.getPath(), SyslogFormat::RFC5424, "myapp");
+    AsyncSender sender(16, AsyncOverflowPolicy::Block, transport);
+    const auto time = AsyncSender::Clock::from_time_t(1700000000);
+    CHECK(sender.enqueue(LOG_INFO, "Message_1", time));
+    sender.flush();
+    const auto text = listener.receive();
+    CHECK_EQ(text.substr(0, 34), "<14>1 2023-11-14T22:13:20.000000Z ");
+    CHECK_EQ(sender.getSentCount(), 1);
+}
+
+TEST_CASE("AsyncSender: Should count only the log-records that the transport sent")
+{
+    SyslogListener listener;
+    auto transport = std::make_shared<SyslogTransport>(listener.getPath(), SyslogFormat::RFC3164, "myapp");
+    transport->setReconnectInterval(std::chrono::hours(1));
+    listener.close();   //< DAEMON DOWN: Log-records are buffered (not sent).
+    AsyncSender sender(16, AsyncOverflowPolicy::Block, transport);
+    CHECK(sender.enqueue(LOG_INFO, "Message_1"));
+    sender.flush();
+    CHECK_EQ(sender.getSentCount(), 0);
+    CHECK_EQ(transport->getPendingCount(), 1);
+}
+
+TEST_CASE("setupAsync: Should send log-records of modules with the sender thread")
+{
+    SyslogListener listener;
+    auto transport = std::make_shared<SyslogTransport>(listener.getPath(), SyslogFormat::RFC3164, "myapp");
+    auto sender = simplelog::backend_syslog::setupAsync(16, AsyncOverflowPolicy::Block, transport);
+    CHECK_EQ(simplelog::backend_syslog::getAsyncSender(), sender.get());
+
+    auto module = simplelog::backend_syslog::useOrCreateModule("test.async");
+    module->setLevel(LOG_INFO);
+    module->log(LOG_INFO, "Message_{0}", 1);
+    simplelog::backend_syslog::shutdownAsync();
+    CHECK_EQ(simplelog::backend_syslog::getAsyncSender(), nullptr);
+    CHECK_EQ(sender->getSentCount(), 1);
+    CHECK_EQ(messageOf(listener.receive()), "Message_1");
+}
+
+TEST_CASE("setupAsync: Should send the queued log-records at the program end (without shutdownAsync)")
+{
+    SyslogListener listener;
+    const pid_t pid = ::fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0) {
+        // -- CHILD: Uses the transport (after setupAsync) and exits with queued log-records.
+        simplelog::backend_syslog::setupAsync(1024, AsyncOverflowPolicy::Block);
+        auto transport = std::make_shared<SyslogTransport>(listener.getPath(), SyslogFormat::RFC3164, "myapp");
+        simplelog::backend_syslog::useSyslogTransport(transport);
+        auto module = simplelog::backend_syslog::useOrCreateModule("test.async.exit");
+        module->setLevel(LOG_INFO);
+        for (int i = 0; i < 100; ++i) {
+            module->log(LOG_INFO, "Message_{0}", i);
+        }
+        std::exit(EXIT_SUCCESS);
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        CHECK_EQ(messageOf(listener.receive()), "Message_" + std::to_string(i));
+    }
+    int status = 0;
+    REQUIRE_EQ(::waitpid(pid, &status, 0), pid);
+    CHECK(WIFEXITED(status));
+    CHECK_EQ(WEXITSTATUS(status), EXIT_SUCCESS);
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
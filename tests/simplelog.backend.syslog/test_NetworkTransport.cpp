@@ -0,0 +1,192 @@
+/**
+ * @file tests/simplelog.backend.syslog/test_NetworkTransport.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/backend/syslog/Spool.hpp"
+#include "simplelog/backend/syslog/Transport.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// -- LOCAL-INCLUDES:
+#include "NetworkListener.hpp"
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using tests::simplelog::backend_syslog::NetworkListener;
+using simplelog::backend_syslog::SyslogAddress;
+using simplelog::backend_syslog::SyslogBatch;
+using simplelog::backend_syslog::SyslogFormat;
+using simplelog::backend_syslog::SyslogProtocol;
+using simplelog::backend_syslog::SyslogSpool;
+using simplelog::backend_syslog::SyslogTransport;
+
+bool endsWith(const std::string& text, const std::string& suffix)
+{
+    return (text.size() >= suffix.size()) &&
+           (text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0);
+}
+
+//! Temporary directory for spool files (removed with its files).
+class TempDirectory
+{
+private:
+    std::string m_path;
+
+public:
+    TempDirectory()
+    {
+        char pathTemplate[] = "/tmp/simplelog_spool_XXXXXX";
+        m_path = ::mkdtemp(pathTemplate);
+    }
+    ~TempDirectory()
+    {
+        ::unlink((m_path + "/syslog.spool").c_str());
+        ::rmdir(m_path.c_str());
+    }
+
+    std::string getSpoolPath() const { return m_path + "/syslog.spool"; }
+};
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_syslog.NetworkTransport");
+TEST_CASE("SyslogAddress: Should parse socket paths and network addresses")
+{
+    const auto unixAddress = SyslogAddress::parse("/dev/log");
+    CHECK_EQ(unixAddress.protocol, SyslogProtocol::Unix);
+    CHECK_EQ(unixAddress.path, "/dev/log");
+
+    const auto tcpAddress = SyslogAddress::parse("tcp://relay.local:601");
+    CHECK_EQ(tcpAddress.protocol, SyslogProtocol::Tcp);
+    CHECK_EQ(tcpAddress.host, "relay.local");
+    CHECK_EQ(tcpAddress.port, "601");
+
+    const auto udpAddress = SyslogAddress::parse("udp://[::1]");
+    CHECK_EQ(udpAddress.protocol, SyslogProtocol::Udp);
+    CHECK_EQ(udpAddress.host, "::1");
+    CHECK_EQ(udpAddress.port, "514");
+}
+
+TEST_CASE("SyslogTransport: Should send log-records over UDP")
+{
+    NetworkListener listener(false);
+    SyslogTransport transport(listener.getAddress(), SyslogFormat::RFC5424, "myapp");
+    REQUIRE(transport.isConnected());
+
+    CHECK(transport.send(LOG_INFO, "Message_1"));
+    const auto text = listener.receive();
+    CHECK_EQ(text.substr(0, 7), "<14>1 2");
+    CHECK(endsWith(text, " myapp " + std::to_string(::getpid()) + " - - Message_1"));
+}
+
+TEST_CASE("SyslogTransport: Should send octet-counted frames over TCP")
+{
+    NetworkListener listener(true);
+    SyslogTransport transport(listener.getAddress(), SyslogFormat::RFC3164, "myapp");
+    REQUIRE(transport.isConnected());
+
+    CHECK(transport.send(LOG_INFO, "Message_1"));
+    SyslogBatch batch;
+    for (int i = 2; i <= 4; ++i) {
+        batch.add(transport.getEncoder(), LOG_INFO, "Message_" + std::to_string(i));
+    }
+    CHECK_EQ(transport.send(batch), 3);
+    // -- NETWORK: RFC 3164 header contains the hostname.
+    using simplelog::backend_syslog::detail::getHostName;
+    CHECK(endsWith(listener.receive(),
+        " " + getHostName() + " myapp[" + std::to_string(::getpid()) + "]: Message_1"));
+    for (int i = 2; i <= 4; ++i) {
+        CHECK(endsWith(listener.receive(), "]: Message_" + std::to_string(i)));
+    }
+}
+
+TEST_CASE("SyslogTransport: Should spool log-records to disk while the relay is down")
+{
+    TempDirectory directory;
+    NetworkListener listener(true);
+    listener.close();   //< RELAY DOWN: Port is known, but not listening.
+    SyslogTransport transport(listener.getAddress(), SyslogFormat::RFC3164, "myapp");
+    REQUIRE(transport.setSpoolFile(directory.getSpoolPath()));
+    transport.setReconnectInterval(std::chrono::hours(1));
+    CHECK_FALSE(transport.isConnected());
+
+    CHECK(transport.send(LOG_INFO, "Message_1"));
+    CHECK(transport.send(LOG_INFO, "Message_2"));
+    CHECK_EQ(transport.getPendingCount(), 2);
+
+    listener.open();
+    CHECK(transport.flushPending());
+    CHECK_EQ(transport.getPendingCount(), 0);
+    CHECK(endsWith(listener.receive(), "]: Message_1"));
+    CHECK(endsWith(listener.receive(), "]: Message_2"));
+}
+
+TEST_CASE("SyslogTransport: Should wait at most the connect-timeout (if the relay stalls)")
+{
+    // -- RELAY STALLS: Accept queue is full (connection requests are dropped).
+    const int listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    REQUIRE_EQ(::bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)), 0);
+    REQUIRE_EQ(::listen(listenFd, 0), 0);
+    socklen_t size = sizeof(address);
+    ::getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &size);
+    const int clientFd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    REQUIRE_EQ(::connect(clientFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)), 0);
+
+    const auto startTime = std::chrono::steady_clock::now();
+    SyslogTransport transport("tcp://127.0.0.1:" + std::to_string(ntohs(address.sin_port)),
+                              SyslogFormat::RFC3164, "myapp");
+    const auto duration = std::chrono::steady_clock::now() - startTime;
+    CHECK_FALSE(transport.isConnected());
+    CHECK(duration < std::chrono::seconds(2));
+    ::close(clientFd);
+    ::close(listenFd);
+}
+
+TEST_CASE("SyslogSpool: Should keep the log-records of a previous run")
+{
+    TempDirectory directory;
+    {
+        SyslogSpool spool(directory.getSpoolPath());
+        CHECK(spool.append("Hello Alice"));
+        CHECK(spool.append("Hello Bob"));
+    }
+    SyslogSpool spool(directory.getSpoolPath());
+    CHECK_EQ(spool.size(), 2);
+
+    std::string received;
+    CHECK_FALSE(spool.replay([&](std::string_view record) {
+        if (record == "Hello Bob") {
+            return false;   //< SEND FAILED: Keep it (for the next replay).
+        }
+        received += std::string(record) + ";";
+        return true;
+    }));
+    CHECK_EQ(spool.size(), 1);
+    CHECK(spool.replay([&](std::string_view record) {
+        received += std::string(record) + ";";
+        return true;
+    }));
+    CHECK(spool.empty());
+    CHECK_EQ(received, "Hello Alice;Hello Bob;");
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
@@ -0,0 +1,202 @@
+/**
+ * @file tests/simplelog.backend.syslog/test_SetupUtil.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/backend/syslog/Module.hpp"
+#include "simplelog/backend/syslog/SetupUtil.hpp"
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+
+// -- LOCAL-INCLUDES:
+#include "SyslogListener.hpp"
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using tests::simplelog::backend_syslog::SyslogListener;
+using simplelog::backend_syslog::SyslogFormat;
+using simplelog::backend_syslog::SyslogTransport;
+using simplelog::backend_syslog::SyslogTransportPtr;
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_syslog.SetupUtil");
+TEST_CASE("setFacility: Should apply to existing and new modules")
+{
+    auto module1 = simplelog::backend_syslog::useOrCreateModule("test.facility.db.one");
+    simplelog::backend_syslog::setFacility("test.facility.db.*", LOG_LOCAL1);
+    auto module2 = simplelog::backend_syslog::useOrCreateModule("test.facility.db.two");
+    auto module3 = simplelog::backend_syslog::useOrCreateModule("test.facility.other");
+    CHECK_EQ(module1->getFacility(), LOG_LOCAL1);
+    CHECK_EQ(module2->getFacility(), LOG_LOCAL1);
+    CHECK_EQ(module3->getFacility(), 0);
+}
+
+TEST_CASE("setFacility: Should send log-records with the module facility")
+{
+    SyslogListener listener;
+    auto transport = std::make_shared<SyslogTransport>(listener.getPath(), SyslogFormat::RFC3164, "myapp");
+    simplelog::backend_syslog::useSyslogTransport(transport);
+    simplelog::backend_syslog::setFacility("test.facility.net", LOG_LOCAL2);
+    auto module = simplelog::backend_syslog::useOrCreateModule("test.facility.net");
+    module->setLevel(LOG_INFO);
+    module->log(LOG_INFO, "Message_{0}", 1);
+    simplelog::backend_syslog::useSyslogTransport(SyslogTransportPtr());
+    CHECK_EQ(listener.receive().substr(0, 5), "<150>");
+}
+
+TEST_CASE("enableLogMaskSync: Should mirror the most verbose module level into the log mask")
+{
+    using simplelog::backend_syslog::getLogMask;
+    auto module = simplelog::backend_syslog::useOrCreateModule("test.logmask");
+    simplelog::backend_syslog::setDefaultLevel(LOG_WARNING);
+    simplelog::backend_syslog::applyLevelConfig({{"*", "warn", {}}});
+    simplelog::backend_syslog::enableLogMaskSync();
+    CHECK_EQ(getLogMask(), LOG_UPTO(LOG_WARNING));
+    CHECK_EQ(::setlogmask(0), LOG_UPTO(LOG_WARNING));
+
+    module->setLevel(LOG_DEBUG);    //< MORE VERBOSE: Added to the log mask now.
+    CHECK_EQ(getLogMask(), LOG_UPTO(LOG_DEBUG));
+    simplelog::backend_syslog::applyLevelConfig({{"test.logmask", "info", {}}});
+    CHECK_EQ(getLogMask(), LOG_UPTO(LOG_INFO));
+
+    simplelog::backend_syslog::enableLogMaskSync(false);
+    simplelog::backend_syslog::setDefaultLevel(LOG_EMERG);
+    CHECK_EQ(getLogMask(), LOG_UPTO(LOG_DEBUG));
+}
+
+TEST_CASE("enableLogMaskSync: Should widen the log mask for level changes via ModuleBase")
+{
+    using simplelog::backend_syslog::getLogMask;
+    auto module = simplelog::backend_syslog::useOrCreateModule("test.logmask.base");
+    module->setLevel(LOG_WARNING);
+    simplelog::backend_syslog::setDefaultLevel(LOG_WARNING);
+    simplelog::backend_syslog::applyLevelConfig({{"*", "warn", {}}});
+    simplelog::backend_syslog::enableLogMaskSync();
+    CHECK_EQ(getLogMask(), LOG_UPTO(LOG_WARNING));
+
+    simplelog::backend_common::ModuleBase& moduleBase = *module;
+    moduleBase.setLevel(LOG_INFO);  //< NOT HIDDEN: Same hook as Module::setLevel().
+    CHECK_EQ(getLogMask(), LOG_UPTO(LOG_INFO));
+    CHECK_EQ(::setlogmask(0), LOG_UPTO(LOG_INFO));
+    simplelog::backend_syslog::enableLogMaskSync(false);
+}
+
+TEST_CASE("enableLogMaskSync: Should restore the log mask of the application if disabled")
+{
+    using simplelog::backend_syslog::getLogMask;
+    const int applicationMask = LOG_MASK(LOG_ERR) | LOG_MASK(LOG_NOTICE);
+    ::setlogmask(applicationMask);  //< APPLICATION: Calls setlogmask() directly.
+    simplelog::backend_syslog::setDefaultLevel(LOG_WARNING);
+    simplelog::backend_syslog::applyLevelConfig({{"*", "warn", {}}});
+    simplelog::backend_syslog::enableLogMaskSync();
+    CHECK_EQ(getLogMask(), LOG_UPTO(LOG_WARNING));
+
+    simplelog::backend_syslog::enableLogMaskSync(false);
+    CHECK_EQ(getLogMask(), applicationMask);
+    CHECK_EQ(::setlogmask(0), applicationMask);
+    simplelog::backend_syslog::setLogMask(LOG_UPTO(LOG_DEBUG));   //< CLEANUP
+}
+
+TEST_CASE("applyLevelConfig: Should assign levels to modules created later")
+{
+    simplelog::backend_syslog::ModuleRegistry registry;
+    registry.setDefaultLevel(LOG_NOTICE);
+    simplelog::backend_syslog::applyLevelConfig(registry, {
+        {"*",    "warn",  {}},
+        {"db.*", "debug", {}}
+    });
+    auto module1 = registry.useOrCreateModule("db.new");
+    auto module2 = registry.useOrCreateModule("other");
+    CHECK_EQ(module1->getLevel(), LOG_DEBUG);
+    CHECK_EQ(module2->getLevel(), LOG_WARNING);
+
+    // -- CASE: Added entry (as: by a control command) keeps the other entries.
+    simplelog::backend_syslog::addLevelConfig(registry, {{"db.slow", "err", {}}});
+    auto module3 = registry.useOrCreateModule("db.slow");
+    auto module4 = registry.useOrCreateModule("db.other");
+    CHECK_EQ(module3->getLevel(), LOG_ERR);
+    CHECK_EQ(module4->getLevel(), LOG_DEBUG);
+}
+
+TEST_CASE("isLevelEnabled: Should reject levels outside of the log mask")
+{
+    auto module = simplelog::backend_syslog::useOrCreateModule("test.logmask.other");
+    module->setLevel(LOG_INFO);
+    CHECK(module->isLevelEnabled(LOG_INFO));
+
+    ::setlogmask(LOG_UPTO(LOG_WARNING));   //< THIRD-PARTY CODE: Changes the log mask.
+    CHECK_EQ(simplelog::backend_syslog::refreshLogMask(), LOG_UPTO(LOG_WARNING));
+    CHECK_FALSE(module->isLevelEnabled(LOG_INFO));
+    CHECK(module->isLevelEnabled(LOG_WARNING));
+    simplelog::backend_syslog::setLogMask(LOG_UPTO(LOG_DEBUG));
+}
+
+TEST_CASE("setRateLimit: Should summarise the log-records over the module budget")
+{
+    SyslogListener listener;
+    auto transport = std::make_shared<SyslogTransport>(listener.getPath(), SyslogFormat::RFC3164, "myapp");
+    simplelog::backend_syslog::useSyslogTransport(transport);
+    simplelog::backend_common::setRateLimit(std::chrono::milliseconds(50), 1);
+    auto module = simplelog::backend_syslog::useOrCreateModule("test.budget");
+    module->setLevel(LOG_INFO);
+    for (int i = 1; i <= 3; ++i) {
+        module->log(LOG_INFO, "Message_{0}", i);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    module->log(LOG_INFO, "Message_{0}", 4);
+    simplelog::backend_common::disableRateLimit();
+    simplelog::backend_syslog::useSyslogTransport(SyslogTransportPtr());
+
+    CHECK_EQ(module->getDroppedByBudgetCount(), 2);
+    const auto endsWith = [](const std::string& text, const std::string& suffix) {
+        return (text.size() >= suffix.size()) &&
+               (text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0);
+    };
+    CHECK(endsWith(listener.receive(), "]: Message_1"));
+    CHECK(endsWith(listener.receive(), "]: 2 log-records dropped by simplelog budget (module: test.budget)"));
+    CHECK(endsWith(listener.receive(), "]: Message_4"));
+}
+
+TEST_CASE("setRateLimit: Should exit with a module that still owes its budget summary")
+{
+    SyslogListener listener;
+    const pid_t pid = ::fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0) {
+        // -- CHILD: The module is still queued when the static destructors run.
+        auto transport = std::make_shared<SyslogTransport>(listener.getPath(), SyslogFormat::RFC3164, "myapp");
+        simplelog::backend_syslog::useSyslogTransport(transport);
+        simplelog::backend_common::setRateLimit(std::chrono::seconds(30), 1);
+        auto module = simplelog::backend_syslog::useOrCreateModule("test.budget.exit");
+        module->setLevel(LOG_DEBUG);
+        for (int i = 1; i <= 3; ++i) {
+            module->log(LOG_ERR, "Message_{0}", i);
+        }
+        std::exit(EXIT_SUCCESS);
+    }
+
+    int status = 0;
+    REQUIRE_EQ(::waitpid(pid, &status, 0), pid);
+    CHECK(WIFEXITED(status));
+    CHECK_EQ(WEXITSTATUS(status), EXIT_SUCCESS);
+    CHECK_EQ(listener.receive().substr(0, 4), "<11>");
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
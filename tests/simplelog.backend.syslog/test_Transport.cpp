@@ -0,0 +1,185 @@
+/**
+ * @file tests/simplelog.backend.syslog/test_Transport.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/backend/syslog/Transport.hpp"
+#include <chrono>
+#include <clocale>
+#include <string>
+#include <unistd.h>
+
+// -- LOCAL-INCLUDES:
+#include "SyslogListener.hpp"
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using tests::simplelog::backend_syslog::SyslogListener;
+using simplelog::backend_syslog::SyslogBatch;
+using simplelog::backend_syslog::SyslogEncoder;
+using simplelog::backend_syslog::SyslogFormat;
+using simplelog::backend_syslog::SyslogTransport;
+
+std::string encode(const SyslogEncoder& encoder, int level, const std::string& message,
+                   SyslogEncoder::Clock::time_point time)
+{
+    fmt::memory_buffer buffer;
+    encoder.encode(buffer, level, message, time);
+    return fmt::to_string(buffer);
+}
+
+bool endsWith(const std::string& text, const std::string& suffix)
+{
+    return (text.size() >= suffix.size()) &&
+           (text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0);
+}
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_syslog.Transport");
+TEST_CASE("SyslogEncoder: Should encode RFC 5424 log-records")
+{
+    using namespace std::chrono;
+    const SyslogEncoder encoder(SyslogFormat::RFC5424, "myapp", LOG_LOCAL0, "myhost");
+    const auto time = SyslogEncoder::Clock::from_time_t(1700000000) + microseconds(1234);
+    const auto pid = std::to_string(::getpid());
+    CHECK_EQ(encode(encoder, LOG_INFO, "Hello Alice", time),
+        "<134>1 2023-11-14T22:13:20.001234Z myhost myapp " + pid + " - - Hello Alice");
+    CHECK_EQ(encode(encoder, LOG_ERR, "Hello Bob", time + seconds(1)),
+        "<131>1 2023-11-14T22:13:21.001234Z myhost myapp " + pid + " - - Hello Bob");
+}
+
+TEST_CASE("SyslogEncoder: Should encode RFC 3164 log-records (with hostname: network)")
+{
+    const SyslogEncoder encoder(SyslogFormat::RFC3164, "myapp", LOG_USER, "myhost");
+    const auto text = encode(encoder, LOG_WARNING, "Hello Alice", SyslogEncoder::Clock::now());
+    CHECK_EQ(text.substr(0, 4), "<12>");
+    CHECK_EQ(text.size(), 4 + 15 + std::string(" myhost myapp[]: Hello Alice").size() +
+                          std::to_string(::getpid()).size());
+    CHECK(endsWith(text, " myhost myapp[" + std::to_string(::getpid()) + "]: Hello Alice"));
+}
+
+TEST_CASE("SyslogEncoder: Should use English month names (independent of the locale)")
+{
+    const std::string oldLocale = std::setlocale(LC_TIME, nullptr);
+    std::setlocale(LC_TIME, "de_DE.UTF-8");     //< HINT: May be unavailable.
+    const SyslogEncoder encoder(SyslogFormat::RFC3164, "myapp", LOG_USER, "");
+    const auto time = SyslogEncoder::Clock::from_time_t(1697500000);  //< 2023-10-16 (UTC)
+    const auto text = encode(encoder, LOG_WARNING, "Hello Alice", time);
+    std::setlocale(LC_TIME, oldLocale.c_str());
+    CHECK_EQ(text.substr(4, 4), "Oct ");
+    CHECK_EQ(text.substr(4 + 15, 1), " ");
+}
+
+TEST_CASE("SyslogEncoder: Should omit an empty hostname")
+{
+    const auto time = SyslogEncoder::Clock::from_time_t(1700000000);
+    const auto pid = std::to_string(::getpid());
+    const SyslogEncoder encoder3164(SyslogFormat::RFC3164, "myapp", LOG_USER, "");
+    const auto text = encode(encoder3164, LOG_WARNING, "Hello Alice", time);
+    CHECK_EQ(text.substr(0, 4), "<12>");
+    CHECK_EQ(text.substr(4 + 15), " myapp[" + pid + "]: Hello Alice");
+
+    const SyslogEncoder encoder5424(SyslogFormat::RFC5424, "myapp", LOG_USER, "");
+    CHECK_EQ(encode(encoder5424, LOG_WARNING, "Hello Bob", time),
+        "<12>1 2023-11-14T22:13:20.000000Z - myapp " + pid + " - - Hello Bob");
+}
+
+TEST_CASE("SyslogTransport: Should send log-records to the socket")
+{
+    SyslogListener listener;
+    SyslogTransport transport(listener.getPath(), SyslogFormat::RFC3164, "myapp");
+    REQUIRE(transport.isConnected());
+
+    CHECK(transport.send(LOG_INFO, "Message_1"));
+    const auto text = listener.receive();
+    CHECK_EQ(text.substr(0, 4), "<14>");
+    // -- AF_UNIX: "<PRI>Mmm dd hh:mm:ss app[pid]: message" (without hostname).
+    CHECK_EQ(text.substr(4 + 15), " myapp[" + std::to_string(::getpid()) + "]: Message_1");
+}
+
+TEST_CASE("SyslogTransport: Should send a batch of log-records")
+{
+    SyslogListener listener;
+    SyslogTransport transport(listener.getPath(), SyslogFormat::RFC3164, "myapp");
+    SyslogBatch batch;
+    for (int i = 1; i <= 3; ++i) {
+        batch.add(transport.getEncoder(), LOG_INFO, "Message_" + std::to_string(i));
+    }
+    CHECK_EQ(transport.send(batch), 3);
+    CHECK(endsWith(listener.receive(), "]: Message_1"));
+    CHECK(endsWith(listener.receive(), "]: Message_2"));
+    CHECK(endsWith(listener.receive(), "]: Message_3"));
+}
+
+TEST_CASE("SyslogTransport: Should reconnect after the syslog daemon restarted")
+{
+    SyslogListener listener;
+    SyslogTransport transport(listener.getPath(), SyslogFormat::RFC3164, "myapp");
+    listener.close();
+    listener.open();    //< RESTARTED: New socket with same path.
+
+    CHECK(transport.send(LOG_INFO, "Message_1"));
+    CHECK(endsWith(listener.receive(), "]: Message_1"));
+}
+
+TEST_CASE("SyslogEncoder: Should use the facility of the level (if any)")
+{
+    const SyslogEncoder encoder(SyslogFormat::RFC3164, "myapp", LOG_USER, "myhost");
+    const auto text = encode(encoder, LOG_LOCAL1 | LOG_INFO, "Hello Alice", SyslogEncoder::Clock::now());
+    CHECK_EQ(text.substr(0, 5), "<142>");
+}
+
+TEST_CASE("SyslogTransport: Should buffer log-records while the syslog daemon is down")
+{
+    SyslogListener listener;
+    SyslogTransport transport(listener.getPath(), SyslogFormat::RFC3164, "myapp");
+    transport.setReconnectInterval(std::chrono::hours(1));
+    listener.close();   //< DAEMON DOWN: Socket path is gone.
+
+    CHECK(transport.send(LOG_INFO, "Message_1"));
+    CHECK(transport.send(LOG_INFO, "Message_2"));
+    CHECK_EQ(transport.getPendingCount(), 2);
+
+    listener.open();    //< RESTARTED: Reconnect is not due yet (keeps order).
+    CHECK(transport.send(LOG_INFO, "Message_3"));
+    CHECK_EQ(transport.getPendingCount(), 3);
+    CHECK(transport.flushPending());
+    CHECK_EQ(transport.getPendingCount(), 0);
+    CHECK(endsWith(listener.receive(), "]: Message_1"));
+    CHECK(endsWith(listener.receive(), "]: Message_2"));
+    CHECK(endsWith(listener.receive(), "]: Message_3"));
+    CHECK_EQ(transport.getDroppedCount(), 0);
+}
+
+TEST_CASE("SyslogTransport: Should drop the oldest buffered log-records if full")
+{
+    SyslogListener listener;
+    SyslogTransport transport(listener.getPath(), SyslogFormat::RFC3164, "myapp");
+    transport.setReconnectInterval(std::chrono::hours(1));
+    transport.setMaxPending(2);
+    listener.close();
+
+    for (int i = 1; i <= 3; ++i) {
+        transport.send(LOG_INFO, "Message_" + std::to_string(i));
+    }
+    CHECK_EQ(transport.getPendingCount(), 2);
+    CHECK_EQ(transport.getDroppedCount(), 1);
+
+    listener.open();
+    CHECK(transport.flushPending());
+    CHECK(endsWith(listener.receive(), "]: Message_2"));
+    CHECK(endsWith(listener.receive(), "]: Message_3"));
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
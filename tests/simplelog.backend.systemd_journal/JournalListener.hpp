@@ -0,0 +1,118 @@
+/**
+ * @file tests/simplelog.backend.systemd_journal/JournalListener.hpp
+ * Local journald replacement (AF_UNIX datagram socket) for tests.
+ **/
+
+#pragma once
+
+// -- INCLUDES:
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace tests { namespace simplelog { namespace backend_systemd_journal {
+
+/**
+ * @class JournalListener
+ * Receives the log-records that are sent to its socket path.
+ * A log-record that is sent as memfd (SCM_RIGHTS) is read from the memfd.
+ **/
+class JournalListener
+{
+private:
+    std::string m_directory;
+    std::string m_path;
+    int m_fd;
+
+public:
+    JournalListener() : m_directory(), m_path(), m_fd(-1)
+    {
+        char pathTemplate[] = "/tmp/simplelog_journal_XXXXXX";
+        m_directory = ::mkdtemp(pathTemplate);
+        m_path = m_directory + "/socket";
+        open();
+    }
+    ~JournalListener()
+    {
+        close();
+        ::rmdir(m_directory.c_str());
+    }
+
+    const std::string& getPath() const { return m_path; }
+
+    void open()
+    {
+        m_fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, m_path.c_str(), sizeof(address.sun_path) - 1);
+        ::bind(m_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    }
+
+    void close()
+    {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            ::unlink(m_path.c_str());
+            m_fd = -1;
+        }
+    }
+
+    //! Receives the next log-record (or an empty string after the timeout).
+    std::string receive(int timeoutInMillis = 1000)
+    {
+        pollfd pollFd{m_fd, POLLIN, 0};
+        if (::poll(&pollFd, 1, timeoutInMillis) <= 0) {
+            return std::string();
+        }
+        std::vector<char> buffer(64 * 1024);
+        iovec part{buffer.data(), buffer.size()};
+        union {
+            cmsghdr header;
+            char data[CMSG_SPACE(sizeof(int))];
+        } control{};
+        msghdr message{};
+        message.msg_iov = &part;
+        message.msg_iovlen = 1;
+        message.msg_control = &control;
+        message.msg_controllen = sizeof(control);
+        const auto size = ::recvmsg(m_fd, &message, MSG_CMSG_CLOEXEC);
+        if (size < 0) {
+            return std::string();
+        }
+        const cmsghdr* header = CMSG_FIRSTHDR(&message);
+        if (header && (header->cmsg_type == SCM_RIGHTS)) {
+            int memfd = -1;
+            std::memcpy(&memfd, CMSG_DATA(header), sizeof(int));
+            return readMemfd(memfd);
+        }
+        return std::string(buffer.data(), static_cast<std::size_t>(size));
+    }
+
+private:
+    static std::string readMemfd(int memfd)
+    {
+        struct stat info{};
+        ::fstat(memfd, &info);
+        std::string text(static_cast<std::size_t>(info.st_size), '\0');
+        std::size_t offset = 0;
+        while (offset < text.size()) {
+            const auto count = ::pread(memfd, &text[offset], text.size() - offset,
+                                       static_cast<off_t>(offset));
+            if (count <= 0) {
+                break;
+            }
+            offset += static_cast<std::size_t>(count);
+        }
+        ::close(memfd);
+        return text;
+    }
+};
+
+}}} //< NAMESPACE-END: tests::simplelog::backend_systemd_journal
@@ -0,0 +1,57 @@
+/**
+ * @file tests/simplelog.backend.systemd_journal/test_LogMacros.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/LogMacros.hpp"
+#include "simplelog/backend/systemd_journal/Transport.hpp"
+#include <memory>
+#include <string>
+
+// -- LOCAL-INCLUDES:
+#include "JournalListener.hpp"
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using tests::simplelog::backend_systemd_journal::JournalListener;
+using simplelog::backend_systemd_journal::JournalTransport;
+using simplelog::backend_systemd_journal::JournalTransportPtr;
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_systemd_journal.LogMacros");
+TEST_CASE("SIMPLELOGM_INFO: Should send the source location fields of the log statement")
+{
+    JournalListener listener;
+    auto transport = std::make_shared<JournalTransport>(listener.getPath());
+    simplelog::backend_systemd_journal::useJournalTransport(transport);
+    SIMPLELOG_DEFINE_MODULE(module, "test.macros");
+    module->setLevel(LOG_INFO);
+
+    const std::string function(__func__);
+    const auto line = std::to_string(__LINE__ + 1);
+    SIMPLELOGM_INFO(module, "Message_{0}", 1);
+    simplelog::backend_systemd_journal::useJournalTransport(JournalTransportPtr());
+
+#if SIMPLELOG_BACKEND_SYSTEMD_JOURNAL__USE_SOURCE_LOCATION
+    CHECK_EQ(listener.receive(),
+        "MESSAGE=Message_1\nPRIORITY=6\nSIMPLELOG_MODULE=test.macros\n"
+        "CODE_FILE=" __FILE__ "\n"
+        "CODE_LINE=" + line + "\n"
+        "CODE_FUNC=" + function + "\n");
+#else
+    CHECK_EQ(listener.receive(), "MESSAGE=Message_1\nPRIORITY=6\nSIMPLELOG_MODULE=test.macros\n");
+#endif
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)
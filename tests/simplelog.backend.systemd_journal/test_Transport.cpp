@@ -0,0 +1,216 @@
+/**
+ * @file tests/simplelog.backend.systemd_journal/test_Transport.cpp
+ * @note REQUIRES: doctest >= 2.3.5
+ **/
+
+// -- INCLUDES:
+#include "doctest/doctest.h"
+
+// -- MORE-INCLUDES:
+#include "simplelog/backend/systemd_journal/Transport.hpp"
+#include "simplelog/backend/systemd_journal/ModuleRegistry.hpp"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// -- LOCAL-INCLUDES:
+#include "JournalListener.hpp"
+
+namespace {
+
+// ============================================================================
+// TEST SUPPORT:
+// ============================================================================
+using tests::simplelog::backend_systemd_journal::JournalListener;
+using simplelog::backend_systemd_journal::JournalBatch;
+using simplelog::backend_systemd_journal::JournalTransport;
+using simplelog::backend_systemd_journal::JournalTransportPtr;
+
+iovec makeField(std::string_view field)
+{
+    return iovec{const_cast<char*>(field.data()), field.size()};
+}
+
+std::string encode(std::initializer_list<std::string_view> fields)
+{
+    std::vector<iovec> parts;
+    for (const auto& field : fields) {
+        parts.push_back(makeField(field));
+    }
+    fmt::memory_buffer buffer;
+    simplelog::backend_systemd_journal::encodeJournalRecord(buffer, parts.data(), static_cast<int>(parts.size()));
+    return fmt::to_string(buffer);
+}
+
+// ============================================================================
+// TEST SUITE:
+// ============================================================================
+TEST_SUITE_BEGIN("simplelog.backend_systemd_journal.Transport");
+TEST_CASE("encodeJournalRecord: Should encode fields as text lines")
+{
+    CHECK_EQ(encode({"MESSAGE=Hello Alice", "PRIORITY=6"}), "MESSAGE=Hello Alice\nPRIORITY=6\n");
+}
+
+TEST_CASE("encodeJournalRecord: Should encode fields with newlines binary-safe")
+{
+    const std::string expected = std::string("MESSAGE\n") +
+        std::string("\x0b\0\0\0\0\0\0\0", 8) + "Hello\nAlice\n" + "PRIORITY=6\n";
+    CHECK_EQ(encode({"MESSAGE=Hello\nAlice", "PRIORITY=6"}), expected);
+}
+
+TEST_CASE("JournalTransport: Should send log-records to the socket")
+{
+    JournalListener listener;
+    JournalTransport transport(listener.getPath());
+    REQUIRE(transport.isConnected());
+
+    const iovec fields[] = {makeField("MESSAGE=Message_1"), makeField("PRIORITY=6")};
+    CHECK(transport.send(fields, 2));
+    CHECK_EQ(listener.receive(), "MESSAGE=Message_1\nPRIORITY=6\n");
+}
+
+TEST_CASE("JournalTransport: Should send a batch of log-records")
+{
+    JournalListener listener;
+    JournalTransport transport(listener.getPath());
+    JournalBatch batch;
+    for (int i = 1; i <= 3; ++i) {
+        const auto message = "MESSAGE=Message_" + std::to_string(i);
+        const iovec fields[] = {makeField(message)};
+        batch.add(fields, 1);
+    }
+    CHECK_EQ(transport.send(batch), 3);
+    CHECK_EQ(listener.receive(), "MESSAGE=Message_1\n");
+    CHECK_EQ(listener.receive(), "MESSAGE=Message_2\n");
+    CHECK_EQ(listener.receive(), "MESSAGE=Message_3\n");
+}
+
+TEST_CASE("JournalTransport: Should send large log-records with a memfd")
+{
+    JournalListener listener;
+    JournalTransport transport(listener.getPath());
+    const auto message = "MESSAGE=" + std::string(4 * 1024 * 1024, 'x');
+    const iovec fields[] = {makeField(message)};
+    CHECK(transport.send(fields, 1));
+    CHECK_EQ(transport.getMemfdCount(), 1);
+    CHECK_EQ(listener.receive(), message + "\n");
+}
+
+TEST_CASE("JournalTransport: Should reconnect after journald restarted")
+{
+    JournalListener listener;
+    JournalTransport transport(listener.getPath());
+    listener.close();
+    listener.open();    //< RESTARTED: New socket with same path.
+
+    const iovec fields[] = {makeField("MESSAGE=Message_1")};
+    CHECK(transport.send(fields, 1));
+    CHECK_EQ(listener.receive(), "MESSAGE=Message_1\n");
+}
+
+TEST_CASE("JournalTransport: Should rate-limit reconnects while journald is gone")
+{
+    JournalListener listener;
+    JournalTransport transport(listener.getPath());
+    transport.setReconnectInterval(std::chrono::milliseconds(200));
+    listener.close();   //< JOURNALD GONE: Reconnect fails.
+
+    const iovec fields[] = {makeField("MESSAGE=Message_1")};
+    CHECK_FALSE(transport.send(fields, 1));
+    listener.open();    //< RESTARTED: But the next reconnect is not due yet.
+    CHECK_FALSE(transport.send(fields, 1));
+    CHECK_EQ(listener.receive(50), "");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    CHECK(transport.send(fields, 1));
+    CHECK_EQ(listener.receive(), "MESSAGE=Message_1\n");
+}
+
+TEST_CASE("useJournalTransport: Should send log-records of modules with structured fields")
+{
+    JournalListener listener;
+    auto transport = std::make_shared<JournalTransport>(listener.getPath());
+    simplelog::backend_systemd_journal::useJournalTransport(transport);
+
+    auto module = simplelog::backend_systemd_journal::useOrCreateModule("test.journal");
+    module->setLevel(LOG_INFO);
+    module->log(LOG_INFO, "Message_{0}", 1);
+    simplelog::backend_systemd_journal::useJournalTransport(JournalTransportPtr());
+    CHECK_EQ(listener.receive(), "MESSAGE=Message_1\nPRIORITY=6\nSIMPLELOG_MODULE=test.journal\n");
+}
+
+TEST_CASE("setRateLimit: Should summarise the log-records over the module budget")
+{
+    JournalListener listener;
+    auto transport = std::make_shared<JournalTransport>(listener.getPath());
+    simplelog::backend_systemd_journal::useJournalTransport(transport);
+    simplelog::backend_common::setRateLimit(std::chrono::milliseconds(50), 1);
+    auto module = simplelog::backend_systemd_journal::useOrCreateModule("test.budget");
+    module->setLevel(LOG_INFO);
+    for (int i = 1; i <= 3; ++i) {
+        module->log(LOG_INFO, "Message_{0}", i);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    module->log(LOG_INFO, "Message_{0}", 4);
+    simplelog::backend_common::disableRateLimit();
+    simplelog::backend_systemd_journal::useJournalTransport(JournalTransportPtr());
+
+    CHECK_EQ(module->getDroppedByBudgetCount(), 2);
+    CHECK_EQ(listener.receive(), "MESSAGE=Message_1\nPRIORITY=6\nSIMPLELOG_MODULE=test.budget\n");
+    CHECK_EQ(listener.receive(), "MESSAGE=2 log-records dropped by simplelog budget (module: test.budget)\n"
+                                 "PRIORITY=4\nSIMPLELOG_MODULE=test.budget\n");
+    CHECK_EQ(listener.receive(), "MESSAGE=Message_4\nPRIORITY=6\nSIMPLELOG_MODULE=test.budget\n");
+}
+
+TEST_CASE("setRateLimit: Should send the summary of a module with the next log-record of any module")
+{
+    JournalListener listener;
+    auto transport = std::make_shared<JournalTransport>(listener.getPath());
+    simplelog::backend_systemd_journal::useJournalTransport(transport);
+    simplelog::backend_common::setRateLimit(std::chrono::milliseconds(50), 1);
+    auto module1 = simplelog::backend_systemd_journal::useOrCreateModule("test.budget.noisy");
+    auto module2 = simplelog::backend_systemd_journal::useOrCreateModule("test.budget.other");
+    module1->setLevel(LOG_INFO);
+    module2->setLevel(LOG_INFO);
+    for (int i = 1; i <= 3; ++i) {
+        module1->log(LOG_INFO, "Message_{0}", i);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    module2->log(LOG_INFO, "Message_{0}", 4);
+    simplelog::backend_common::disableRateLimit();
+    simplelog::backend_systemd_journal::useJournalTransport(JournalTransportPtr());
+
+    CHECK_EQ(module1->getDroppedByBudgetCount(), 2);
+    CHECK_EQ(listener.receive(), "MESSAGE=Message_1\nPRIORITY=6\nSIMPLELOG_MODULE=test.budget.noisy\n");
+    CHECK_EQ(listener.receive(), "MESSAGE=2 log-records dropped by simplelog budget (module: test.budget.noisy)\n"
+                                 "PRIORITY=4\nSIMPLELOG_MODULE=test.budget.noisy\n");
+    CHECK_EQ(listener.receive(), "MESSAGE=Message_4\nPRIORITY=6\nSIMPLELOG_MODULE=test.budget.other\n");
+}
+
+TEST_CASE("flushBudgetSummaries: Should send the summary after the module stopped logging")
+{
+    JournalListener listener;
+    auto transport = std::make_shared<JournalTransport>(listener.getPath());
+    simplelog::backend_systemd_journal::useJournalTransport(transport);
+    simplelog::backend_common::setRateLimit(std::chrono::milliseconds(50), 1);
+    auto module = simplelog::backend_systemd_journal::useOrCreateModule("test.budget.stopped");
+    module->setLevel(LOG_INFO);
+    for (int i = 1; i <= 2; ++i) {
+        module->log(LOG_INFO, "Message_{0}", i);
+    }
+    simplelog::backend_common::ModuleBase::flushBudgetSummaries();     //< WINDOW NOT ENDED: No summary.
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    simplelog::backend_common::ModuleBase::flushBudgetSummaries();
+    simplelog::backend_common::disableRateLimit();
+    simplelog::backend_systemd_journal::useJournalTransport(JournalTransportPtr());
+
+    CHECK_EQ(listener.receive(), "MESSAGE=Message_1\nPRIORITY=6\nSIMPLELOG_MODULE=test.budget.stopped\n");
+    CHECK_EQ(listener.receive(), "MESSAGE=1 log-records dropped by simplelog budget (module: test.budget.stopped)\n"
+                                 "PRIORITY=4\nSIMPLELOG_MODULE=test.budget.stopped\n");
+}
+
+TEST_SUITE_END();
+} // < NAMESPACE-END.
+//< ENDOF(__TEST_SOURCE_FILE__)